@@ -58,10 +58,42 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xSpinlock; /**< Protects uxEventBits. */
+    #endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Critical sections that access the event bits.  When configUSE_GRANULAR_LOCKS
+ * is 1 the event bits are protected by the event group's own spinlock, so
+ * clearing or reading the bits does not need the kernel locks.  The list of
+ * waiting tasks is still only accessed with the scheduler suspended.
+ * eventLOCK_BITS() is used within those scheduler suspended regions where the
+ * event bits are updated, and must not be held while calling into the kernel.
+ * It compiles away when configUSE_GRANULAR_LOCKS is 0 as suspending the
+ * scheduler is then sufficient.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define eventENTER_CRITICAL( pxEventBits )                 taskENTER_OBJECT_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+    #define eventEXIT_CRITICAL( pxEventBits )                  taskEXIT_OBJECT_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+    #define eventENTER_CRITICAL_FROM_ISR( pxEventBits )        taskENTER_OBJECT_CRITICAL_FROM_ISR( &( ( pxEventBits )->xSpinlock ) )
+    #define eventEXIT_CRITICAL_FROM_ISR( pxEventBits, x )      taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( ( pxEventBits )->xSpinlock ), ( x ) )
+    #define eventLOCK_BITS( pxEventBits )                      taskENTER_OBJECT_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+    #define eventUNLOCK_BITS( pxEventBits )                    taskEXIT_OBJECT_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+#else
+    #define eventENTER_CRITICAL( pxEventBits )                 taskENTER_CRITICAL()
+    #define eventEXIT_CRITICAL( pxEventBits )                  taskEXIT_CRITICAL()
+    #define eventENTER_CRITICAL_FROM_ISR( pxEventBits )        taskENTER_CRITICAL_FROM_ISR()
+    #define eventEXIT_CRITICAL_FROM_ISR( pxEventBits, x )      taskEXIT_CRITICAL_FROM_ISR( x )
+    #define eventLOCK_BITS( pxEventBits )
+    #define eventUNLOCK_BITS( pxEventBits )
+#endif /* configUSE_GRANULAR_LOCKS */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Test the bits set in uxCurrentEventBits to see if the wait condition is met.
  * The wait condition is defined by xWaitForAllBits.  If xWaitForAllBits is
@@ -105,6 +137,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( pxEventBits->xSpinlock ) );
+            }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note that
@@ -160,6 +198,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( pxEventBits->xSpinlock ) );
+            }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note this
@@ -206,7 +250,11 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
-        uxOriginalBitValue = pxEventBits->uxEventBits;
+        eventLOCK_BITS( pxEventBits );
+        {
+            uxOriginalBitValue = pxEventBits->uxEventBits;
+        }
+        eventUNLOCK_BITS( pxEventBits );
 
         ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
@@ -217,7 +265,11 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
 
             /* Rendezvous always clear the bits.  They will have been cleared
              * already unless this is the only task in the rendezvous. */
-            pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+            eventLOCK_BITS( pxEventBits );
+            {
+                pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+            }
+            eventUNLOCK_BITS( pxEventBits );
 
             xTicksToWait = 0;
         }
@@ -269,7 +321,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
         if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
         {
             /* The task timed out, just return the current event bit value. */
-            taskENTER_CRITICAL();
+            eventENTER_CRITICAL( pxEventBits );
             {
                 uxReturn = pxEventBits->uxEventBits;
 
@@ -286,7 +338,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            taskEXIT_CRITICAL();
+            eventEXIT_CRITICAL( pxEventBits );
 
             xTimeoutOccurred = pdTRUE;
         }
@@ -337,20 +389,17 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
-        const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
+        EventBits_t uxCurrentEventBits;
 
-        /* Check to see if the wait condition is already met or not. */
-        xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
-
-        if( xWaitConditionMet != pdFALSE )
+        eventLOCK_BITS( pxEventBits );
         {
-            /* The wait condition has already been met so there is no need to
-             * block. */
-            uxReturn = uxCurrentEventBits;
-            xTicksToWait = ( TickType_t ) 0;
+            uxCurrentEventBits = pxEventBits->uxEventBits;
+
+            /* Check to see if the wait condition is already met or not. */
+            xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
 
             /* Clear the wait bits if requested to do so. */
-            if( xClearOnExit != pdFALSE )
+            if( ( xWaitConditionMet != pdFALSE ) && ( xClearOnExit != pdFALSE ) )
             {
                 pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
             }
@@ -359,6 +408,15 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        eventUNLOCK_BITS( pxEventBits );
+
+        if( xWaitConditionMet != pdFALSE )
+        {
+            /* The wait condition has already been met so there is no need to
+             * block. */
+            uxReturn = uxCurrentEventBits;
+            xTicksToWait = ( TickType_t ) 0;
+        }
         else if( xTicksToWait == ( TickType_t ) 0 )
         {
             /* The wait condition has not been met, but no block time was
@@ -424,7 +482,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
         if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
         {
-            taskENTER_CRITICAL();
+            eventENTER_CRITICAL( pxEventBits );
             {
                 /* The task timed out, just return the current event bit value. */
                 uxReturn = pxEventBits->uxEventBits;
@@ -449,7 +507,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
                 xTimeoutOccurred = pdTRUE;
             }
-            taskEXIT_CRITICAL();
+            eventEXIT_CRITICAL( pxEventBits );
         }
         else
         {
@@ -484,7 +542,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    taskENTER_CRITICAL();
+    eventENTER_CRITICAL( pxEventBits );
     {
         traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear );
 
@@ -495,7 +553,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
         /* Clear the bits. */
         pxEventBits->uxEventBits &= ~uxBitsToClear;
     }
-    taskEXIT_CRITICAL();
+    eventEXIT_CRITICAL( pxEventBits );
 
     traceRETURN_xEventGroupClearBits( uxReturn );
 
@@ -526,16 +584,16 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
 EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 {
     UBaseType_t uxSavedInterruptStatus;
-    EventGroup_t const * const pxEventBits = xEventGroup;
+    EventGroup_t * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
     traceENTER_xEventGroupGetBitsFromISR( xEventGroup );
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = eventENTER_CRITICAL_FROM_ISR( pxEventBits );
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    eventEXIT_CRITICAL_FROM_ISR( pxEventBits, uxSavedInterruptStatus );
 
     traceRETURN_xEventGroupGetBitsFromISR( uxReturn );
 
@@ -570,7 +628,11 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
         pxListItem = listGET_HEAD_ENTRY( pxList );
 
         /* Set the bits. */
-        pxEventBits->uxEventBits |= uxBitsToSet;
+        eventLOCK_BITS( pxEventBits );
+        {
+            pxEventBits->uxEventBits |= uxBitsToSet;
+        }
+        eventUNLOCK_BITS( pxEventBits );
 
         /* See if the new bit value should unblock any tasks. */
         while( pxListItem != pxListEnd )
@@ -633,7 +695,11 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
 
         /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
          * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        eventLOCK_BITS( pxEventBits );
+        {
+            pxEventBits->uxEventBits &= ~uxBitsToClear;
+        }
+        eventUNLOCK_BITS( pxEventBits );
     }
     ( void ) xTaskResumeAll();
 
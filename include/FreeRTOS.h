@@ -260,6 +260,61 @@
     #define INCLUDE_xTaskGetHandle    0
 #endif
 
+#ifndef configUSE_TASK_NAME_INDEX
+    #define configUSE_TASK_NAME_INDEX    0
+#endif
+
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+    #if ( INCLUDE_xTaskGetHandle != 1 )
+        #error configUSE_TASK_NAME_INDEX is set to 1 but INCLUDE_xTaskGetHandle is not set to 1.  The index is only used by xTaskGetHandle().
+    #endif
+
+/* The number of hash buckets in the index used by xTaskGetHandle(). */
+    #ifndef configTASK_NAME_INDEX_SIZE
+        #define configTASK_NAME_INDEX_SIZE    16
+    #endif
+
+    #if ( configTASK_NAME_INDEX_SIZE < 1 )
+        #error configTASK_NAME_INDEX_SIZE must be at least 1
+    #endif
+
+#endif /* configUSE_TASK_NAME_INDEX */
+
+#ifndef configUSE_TASK_BATCH_CREATION
+    #define configUSE_TASK_BATCH_CREATION    0
+#endif
+
+#if ( configUSE_TASK_BATCH_CREATION == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configUSE_TASK_BATCH_CREATION is set to 1 but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.  xTaskCreateBatch() allocates its tasks from the heap.
+    #endif
+
+    #if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+        #error configUSE_TASK_BATCH_CREATION cannot be used with configSTACK_ALLOCATION_FROM_SEPARATE_HEAP as the TCBs and stacks are allocated from a single block.
+    #endif
+
+#endif /* configUSE_TASK_BATCH_CREATION */
+
+#ifndef configUSE_TASK_SNAPSHOTS
+    #define configUSE_TASK_SNAPSHOTS    0
+#endif
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+/* The number of tasks for which uxTaskGetSnapshot() can report information.
+ * Tasks created while the table is full are omitted from the snapshot. */
+    #ifndef configTASK_SNAPSHOT_TABLE_SIZE
+        #define configTASK_SNAPSHOT_TABLE_SIZE    16
+    #endif
+
+    #if ( configTASK_SNAPSHOT_TABLE_SIZE < 1 )
+        #error configTASK_SNAPSHOT_TABLE_SIZE must be at least 1
+    #endif
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+
 #ifndef INCLUDE_uxTaskGetStackHighWaterMark
     #define INCLUDE_uxTaskGetStackHighWaterMark    0
 #endif
@@ -268,6 +323,32 @@
     #define INCLUDE_uxTaskGetStackHighWaterMark2    0
 #endif
 
+#ifndef configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK
+    #define configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK    0
+#endif
+
+#ifndef configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN
+    #define configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN    0
+#endif
+
+#if ( configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN == 1 )
+
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK != 1 )
+        #error configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN is set to 1 but configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is not set to 1.
+    #endif
+
+/* The number of consecutive stack words that still hold their fill value that
+ * ends a high water mark scan. */
+    #ifndef configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW
+        #define configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW    32
+    #endif
+
+    #if ( configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW < 1 )
+        #error configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW must be at least 1
+    #endif
+
+#endif /* configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN */
+
 #ifndef INCLUDE_eTaskGetState
     #define INCLUDE_eTaskGetState    0
 #endif
@@ -314,6 +395,52 @@
     #define configUSE_MUTEXES    0
 #endif
 
+/* Set configUSE_MUTEX_PRIORITY_CEILING to 1 to include
+ * xSemaphoreCreateMutexWithCeiling(), which creates mutexes that use the
+ * immediate priority ceiling protocol instead of priority inheritance. */
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
+/* Set configUSE_TRANSITIVE_PRIORITY_INHERITANCE to 1 to have a task that
+ * blocks on a mutex raise the priority of every task along the chain of mutex
+ * holders that are themselves blocked on mutexes, up to
+ * configMAX_PRIORITY_INHERITANCE_DEPTH holders deep. */
+#ifndef configUSE_TRANSITIVE_PRIORITY_INHERITANCE
+    #define configUSE_TRANSITIVE_PRIORITY_INHERITANCE    0
+#endif
+
+#ifndef configMAX_PRIORITY_INHERITANCE_DEPTH
+    #define configMAX_PRIORITY_INHERITANCE_DEPTH    4
+#endif
+
+/* Set configUSE_ADAPTIVE_MUTEXES to 1 to have a task that finds a mutex held
+ * by a task running on another core spin for up to
+ * configADAPTIVE_MUTEX_SPIN_COUNT iterations waiting for the mutex to be
+ * released before blocking on it.  Only applicable to SMP builds. */
+#ifndef configUSE_ADAPTIVE_MUTEXES
+    #define configUSE_ADAPTIVE_MUTEXES    0
+#endif
+
+#ifndef configADAPTIVE_MUTEX_SPIN_COUNT
+    #define configADAPTIVE_MUTEX_SPIN_COUNT    1000U
+#endif
+
+/* Set configUSE_MUTEX_FAST_PATH to 1 to have uncontended mutexes taken and
+ * given with an atomic compare-and-swap on the mutex holder, rather than
+ * within a critical section.  SMP ports must provide an atomic.h that uses
+ * atomic instructions, as the generic implementation only masks interrupts on
+ * the calling core. */
+#ifndef configUSE_MUTEX_FAST_PATH
+    #define configUSE_MUTEX_FAST_PATH    0
+#endif
+
+/* Set configUSE_RWLOCKS to 1 to include the reader-writer lock API defined in
+ * rwlock.h. */
+#ifndef configUSE_RWLOCKS
+    #define configUSE_RWLOCKS    0
+#endif
+
 #ifndef configUSE_TIMERS
     #define configUSE_TIMERS    0
 #endif
@@ -322,6 +449,17 @@
     #define configUSE_COUNTING_SEMAPHORES    0
 #endif
 
+/* Set configTCB_CACHE_LINE_SIZE to the data cache line size of the target, in
+ * bytes, to group the TCB members that are accessed when tasks are scheduled,
+ * blocked and unblocked at the start of the TCB, and start the remaining
+ * members on the following cache line.  The TCB is only aligned to cache lines
+ * if the memory it occupies is, so statically allocated TCBs should be placed
+ * on a cache line boundary by the application.  Leave undefined or set to 0 to
+ * keep the default TCB layout. */
+#ifndef configTCB_CACHE_LINE_SIZE
+    #define configTCB_CACHE_LINE_SIZE    0
+#endif
+
 #ifndef configUSE_TASK_PREEMPTION_DISABLE
     #define configUSE_TASK_PREEMPTION_DISABLE    0
 #endif
@@ -373,6 +511,12 @@
     #define portSOFTWARE_BARRIER()
 #endif
 
+/* Executed on each iteration of an adaptive mutex spin.  A port can define
+ * this to an instruction that tells the core it is in a spin-wait loop. */
+#ifndef portSPIN_WAIT_HINT
+    #define portSPIN_WAIT_HINT()
+#endif
+
 #ifndef configRUN_MULTIPLE_PRIORITIES
     #define configRUN_MULTIPLE_PRIORITIES    0
 #endif
@@ -473,6 +617,57 @@
     #define configUSE_CORE_AFFINITY    0
 #endif /* configUSE_CORE_AFFINITY */
 
+/* Set configUSE_PER_CORE_READY_LISTS to 1 to hold ready tasks that can only
+ * run on one core in ready lists private to that core, so other cores do not
+ * search past them when selecting a task to run.  Tasks that can run on more
+ * than one core remain in the shared ready lists, from which every core
+ * selects, so there is no per core run queue for them and no work stealing.
+ * All the ready lists are still protected by the kernel locks, so this
+ * shortens the time the locks are held but does not remove contention on
+ * them. */
+#ifndef configUSE_PER_CORE_READY_LISTS
+    #define configUSE_PER_CORE_READY_LISTS    0
+#endif /* configUSE_PER_CORE_READY_LISTS */
+
+/* Set configUSE_GRANULAR_LOCKS to 1 to give each queue, semaphore, stream
+ * buffer and event group its own spinlock, so operations on unrelated objects
+ * that do not need to block or unblock a task do not take the kernel locks. */
+#ifndef configUSE_GRANULAR_LOCKS
+    #define configUSE_GRANULAR_LOCKS    0
+#endif /* configUSE_GRANULAR_LOCKS */
+
+#ifndef portSPINLOCK_TYPE
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #error portSPINLOCK_TYPE is required when configUSE_GRANULAR_LOCKS is 1
+    #endif
+
+#endif /* portSPINLOCK_TYPE */
+
+#ifndef portINIT_SPINLOCK
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #error portINIT_SPINLOCK is required when configUSE_GRANULAR_LOCKS is 1
+    #endif
+
+#endif /* portINIT_SPINLOCK */
+
+#ifndef portGET_SPINLOCK
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #error portGET_SPINLOCK is required when configUSE_GRANULAR_LOCKS is 1
+    #endif
+
+#endif /* portGET_SPINLOCK */
+
+#ifndef portRELEASE_SPINLOCK
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #error portRELEASE_SPINLOCK is required when configUSE_GRANULAR_LOCKS is 1
+    #endif
+
+#endif /* portRELEASE_SPINLOCK */
+
 #ifndef configUSE_PASSIVE_IDLE_HOOK
     #define configUSE_PASSIVE_IDLE_HOOK    0
 #endif /* configUSE_PASSIVE_IDLE_HOOK */
@@ -518,6 +713,21 @@
     #define portSETUP_TCB( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+/* An SMP port can keep the handle of the task running on each core in
+ * core-local storage, such as a register reserved for the purpose, and define
+ * portGET_CURRENT_TCB() to read it.  The kernel then finds the running task
+ * without masking interrupts to index pxCurrentTCBs[] by core ID.  The kernel
+ * calls portSET_CURRENT_TCB() on a core each time it selects the task to run
+ * on that core, including once on the core that starts the scheduler; the
+ * port must load the value itself for the first task it starts on any other
+ * core.  A port that runs each task in its own thread can instead set a
+ * thread-local variable once, when the thread first runs, and leave
+ * portSET_CURRENT_TCB() undefined.  Single core builds always read
+ * pxCurrentTCB directly. */
+#ifndef portSET_CURRENT_TCB
+    #define portSET_CURRENT_TCB( pxTCB )    ( void ) ( pxTCB )
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
     #define configQUEUE_REGISTRY_SIZE    0U
 #endif
@@ -532,6 +742,22 @@
     #define configUSE_MINI_LIST_ITEM    1
 #endif
 
+/* Set configUSE_SKIP_LISTS to 1 to have vListInsert() find the insertion point
+ * in O(log n) time, using express links that skip over runs of list items,
+ * rather than walking the list.  This benefits long delayed, event and timer
+ * lists at the cost of 2 * configSKIP_LIST_LEVELS pointers in every list item
+ * and list end marker. */
+#ifndef configUSE_SKIP_LISTS
+    #define configUSE_SKIP_LISTS    0
+#endif
+
+/* The number of express levels above the ordinary list links when
+ * configUSE_SKIP_LISTS is 1.  Each level links about a quarter of the items on
+ * the level below, so 4 levels keep insertions fast up to about 1000 items. */
+#ifndef configSKIP_LIST_LEVELS
+    #define configSKIP_LIST_LEVELS    4U
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
@@ -1138,6 +1364,142 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateMutexWithCeiling
+    #define traceENTER_xQueueCreateMutexWithCeiling( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeiling
+    #define traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateMutexWithCeilingStatic
+    #define traceENTER_xQueueCreateMutexWithCeilingStatic( uxCeilingPriority, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeilingStatic
+    #define traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue )
+#endif
+
+#ifndef traceENTER_vQueueGetAdaptiveMutexStats
+    #define traceENTER_vQueueGetAdaptiveMutexStats( xMutex, pulSpinAcquisitions, pulBlockingWaits )
+#endif
+
+#ifndef traceRETURN_vQueueGetAdaptiveMutexStats
+    #define traceRETURN_vQueueGetAdaptiveMutexStats()
+#endif
+
+#ifndef traceENTER_xQueueCreateRWLock
+    #define traceENTER_xQueueCreateRWLock( xPreferWriters )
+#endif
+
+#ifndef traceRETURN_xQueueCreateRWLock
+    #define traceRETURN_xQueueCreateRWLock( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateRWLockStatic
+    #define traceENTER_xQueueCreateRWLockStatic( xPreferWriters, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateRWLockStatic
+    #define traceRETURN_xQueueCreateRWLockStatic( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueReserveSend
+    #define traceENTER_xQueueReserveSend( xQueue, ppvSlot, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReserveSend
+    #define traceRETURN_xQueueReserveSend( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueCommitSend
+    #define traceENTER_xQueueCommitSend( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCommitSend
+    #define traceRETURN_xQueueCommitSend( xReturn )
+#endif
+
+#ifndef traceENTER_xQueuePeekReserve
+    #define traceENTER_xQueuePeekReserve( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueuePeekReserve
+    #define traceRETURN_xQueuePeekReserve( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReleaseReceive
+    #define traceENTER_xQueueReleaseReceive( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueReleaseReceive
+    #define traceRETURN_xQueueReleaseReceive( xReturn )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultiple
+    #define traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultiple
+    #define traceRETURN_uxQueueSendMultiple( uxReturn )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultiple
+    #define traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultiple
+    #define traceRETURN_uxQueueReceiveMultiple( uxReturn )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultipleFromISR
+    #define traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultipleFromISR
+    #define traceRETURN_uxQueueSendMultipleFromISR( uxReturn )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultipleFromISR
+    #define traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultipleFromISR
+    #define traceRETURN_uxQueueReceiveMultipleFromISR( uxReturn )
+#endif
+
+#ifndef traceENTER_xQueueRWLockTake
+    #define traceENTER_xQueueRWLockTake( xRWLock, xTicksToWait, xForWriting )
+#endif
+
+#ifndef traceRETURN_xQueueRWLockTake
+    #define traceRETURN_xQueueRWLockTake( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRWLockGive
+    #define traceENTER_xQueueRWLockGive( xRWLock, xForWriting )
+#endif
+
+#ifndef traceRETURN_xQueueRWLockGive
+    #define traceRETURN_xQueueRWLockGive( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRWLockTakeReadFromISR
+    #define traceENTER_xQueueRWLockTakeReadFromISR( xRWLock )
+#endif
+
+#ifndef traceRETURN_xQueueRWLockTakeReadFromISR
+    #define traceRETURN_xQueueRWLockTakeReadFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRWLockGiveReadFromISR
+    #define traceENTER_xQueueRWLockGiveReadFromISR( xRWLock, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueRWLockGiveReadFromISR
+    #define traceRETURN_xQueueRWLockGiveReadFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1658,6 +2020,14 @@
     #define traceRETURN_xTaskCreate( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreateBatch
+    #define traceENTER_xTaskCreateBatch( pxTaskDefinitions, uxNumberOfTasks )
+#endif
+
+#ifndef traceRETURN_xTaskCreateBatch
+    #define traceRETURN_xTaskCreateBatch( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateAffinitySet
     #define traceENTER_xTaskCreateAffinitySet( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, uxCoreAffinityMask, pxCreatedTask )
 #endif
@@ -1858,6 +2228,58 @@
     #define traceRETURN_pcTaskGetName( pcTaskName )
 #endif
 
+#ifndef traceENTER_xTaskCreateWithDeadline
+    #define traceENTER_xTaskCreateWithDeadline( pxTaskCode, pcName, usStackDepth, pvParameters, xRelativeDeadline, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreateWithDeadline
+    #define traceRETURN_xTaskCreateWithDeadline( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetDeadline
+    #define traceENTER_vTaskSetDeadline( xTask, xRelativeDeadline )
+#endif
+
+#ifndef traceRETURN_vTaskSetDeadline
+    #define traceRETURN_vTaskSetDeadline()
+#endif
+
+#ifndef traceENTER_xTaskGetDeadline
+    #define traceENTER_xTaskGetDeadline( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetDeadline
+    #define traceRETURN_xTaskGetDeadline( xDeadline )
+#endif
+
+#ifndef traceENTER_vTaskGetDeadlineStats
+    #define traceENTER_vTaskGetDeadlineStats( pxDeadlineStats )
+#endif
+
+#ifndef traceRETURN_vTaskGetDeadlineStats
+    #define traceRETURN_vTaskGetDeadlineStats()
+#endif
+
+#ifndef traceENTER_vTaskSetBudget
+    #define traceENTER_vTaskSetBudget( xTask, xBudget, xPeriod )
+#endif
+
+#ifndef traceRETURN_vTaskSetBudget
+    #define traceRETURN_vTaskSetBudget()
+#endif
+
+#ifndef traceENTER_xTaskGetBudgetRemaining
+    #define traceENTER_xTaskGetBudgetRemaining( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetBudgetRemaining
+    #define traceRETURN_xTaskGetBudgetRemaining( xBudgetRemaining )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+    #define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
 #ifndef traceENTER_xTaskGetHandle
     #define traceENTER_xTaskGetHandle( pcNameToQuery )
 #endif
@@ -1882,6 +2304,14 @@
     #define traceRETURN_uxTaskGetSystemState( uxTask )
 #endif
 
+#ifndef traceENTER_uxTaskGetSnapshot
+    #define traceENTER_uxTaskGetSnapshot( pxSnapshotArray, uxArraySize )
+#endif
+
+#ifndef traceRETURN_uxTaskGetSnapshot
+    #define traceRETURN_uxTaskGetSnapshot( uxTask )
+#endif
+
 #if ( configNUMBER_OF_CORES == 1 )
     #ifndef traceENTER_xTaskGetIdleTaskHandle
         #define traceENTER_xTaskGetIdleTaskHandle()
@@ -1912,6 +2342,14 @@
     #define traceRETURN_xTaskCatchUpTicks( xYieldOccurred )
 #endif
 
+#ifndef traceENTER_xTaskAnnounceTicks
+    #define traceENTER_xTaskAnnounceTicks( xTicksElapsed )
+#endif
+
+#ifndef traceRETURN_xTaskAnnounceTicks
+    #define traceRETURN_xTaskAnnounceTicks( xSwitchRequired )
+#endif
+
 #ifndef traceENTER_xTaskAbortDelay
     #define traceENTER_xTaskAbortDelay( xTask )
 #endif
@@ -2160,6 +2598,14 @@
     #define traceRETURN_vTaskPriorityDisinheritAfterTimeout()
 #endif
 
+#ifndef traceENTER_vTaskPriorityRaiseToCeiling
+    #define traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_vTaskPriorityRaiseToCeiling
+    #define traceRETURN_vTaskPriorityRaiseToCeiling()
+#endif
+
 #ifndef traceENTER_vTaskYieldWithinAPI
     #define traceENTER_vTaskYieldWithinAPI()
 #endif
@@ -2200,6 +2646,38 @@
     #define traceRETURN_vTaskExitCriticalFromISR()
 #endif
 
+#ifndef traceENTER_vTaskEnterObjectCritical
+    #define traceENTER_vTaskEnterObjectCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskEnterObjectCritical
+    #define traceRETURN_vTaskEnterObjectCritical()
+#endif
+
+#ifndef traceENTER_vTaskExitObjectCritical
+    #define traceENTER_vTaskExitObjectCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskExitObjectCritical
+    #define traceRETURN_vTaskExitObjectCritical()
+#endif
+
+#ifndef traceENTER_uxTaskEnterObjectCriticalFromISR
+    #define traceENTER_uxTaskEnterObjectCriticalFromISR( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_uxTaskEnterObjectCriticalFromISR
+    #define traceRETURN_uxTaskEnterObjectCriticalFromISR( uxSavedInterruptStatus )
+#endif
+
+#ifndef traceENTER_vTaskExitObjectCriticalFromISR
+    #define traceENTER_vTaskExitObjectCriticalFromISR( pxSpinlock, uxSavedInterruptStatus )
+#endif
+
+#ifndef traceRETURN_vTaskExitObjectCriticalFromISR
+    #define traceRETURN_vTaskExitObjectCriticalFromISR()
+#endif
+
 #ifndef traceENTER_vTaskListTasks
     #define traceENTER_vTaskListTasks( pcWriteBuffer, uxBufferLength )
 #endif
@@ -2216,6 +2694,30 @@
     #define traceRETURN_vTaskGetRunTimeStatistics()
 #endif
 
+#ifndef traceENTER_vTaskStatsEncoderInitialise
+    #define traceENTER_vTaskStatsEncoderInitialise( pxEncoder, pxTaskStatusArrays, uxMaxTasks, xDeltaEncode )
+#endif
+
+#ifndef traceRETURN_vTaskStatsEncoderInitialise
+    #define traceRETURN_vTaskStatsEncoderInitialise()
+#endif
+
+#ifndef traceENTER_xTaskStatsEncode
+    #define traceENTER_xTaskStatsEncode( pxEncoder, pucBuffer, xBufferLength )
+#endif
+
+#ifndef traceRETURN_xTaskStatsEncode
+    #define traceRETURN_xTaskStatsEncode( xBytesWritten )
+#endif
+
+#ifndef traceENTER_xTaskStatsEncodeToStreamBuffer
+    #define traceENTER_xTaskStatsEncodeToStreamBuffer( pxEncoder, xStreamBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskStatsEncodeToStreamBuffer
+    #define traceRETURN_xTaskStatsEncodeToStreamBuffer( xBytesWritten )
+#endif
+
 #ifndef traceENTER_uxTaskResetEventItemValue
     #define traceENTER_uxTaskResetEventItemValue()
 #endif
@@ -2232,6 +2734,38 @@
     #define traceRETURN_pvTaskIncrementMutexHeldCount( pxTCB )
 #endif
 
+#ifndef traceENTER_xTaskDecrementMutexHeldCount
+    #define traceENTER_xTaskDecrementMutexHeldCount()
+#endif
+
+#ifndef traceRETURN_xTaskDecrementMutexHeldCount
+    #define traceRETURN_xTaskDecrementMutexHeldCount( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetBlockingMutex
+    #define traceENTER_vTaskSetBlockingMutex( pvMutex )
+#endif
+
+#ifndef traceRETURN_vTaskSetBlockingMutex
+    #define traceRETURN_vTaskSetBlockingMutex()
+#endif
+
+#ifndef traceENTER_pvTaskGetBlockingMutex
+    #define traceENTER_pvTaskGetBlockingMutex( xTask )
+#endif
+
+#ifndef traceRETURN_pvTaskGetBlockingMutex
+    #define traceRETURN_pvTaskGetBlockingMutex( pvMutex )
+#endif
+
+#ifndef traceENTER_xTaskIsRunningOnAnotherCore
+    #define traceENTER_xTaskIsRunningOnAnotherCore( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskIsRunningOnAnotherCore
+    #define traceRETURN_xTaskIsRunningOnAnotherCore( xReturn )
+#endif
+
 #ifndef traceENTER_ulTaskGenericNotifyTake
     #define traceENTER_ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait )
 #endif
@@ -2320,6 +2854,22 @@
     #define traceRETURN_ulTaskGetIdleRunTimePercent( ulReturn )
 #endif
 
+#ifndef traceENTER_ulTaskGetRunTimeCounterForCore
+    #define traceENTER_ulTaskGetRunTimeCounterForCore( xTask, xCoreID )
+#endif
+
+#ifndef traceRETURN_ulTaskGetRunTimeCounterForCore
+    #define traceRETURN_ulTaskGetRunTimeCounterForCore( ulRunTimeCounter )
+#endif
+
+#ifndef traceENTER_ulTaskGetIdleRunTimeCounterForCore
+    #define traceENTER_ulTaskGetIdleRunTimeCounterForCore( xCoreID )
+#endif
+
+#ifndef traceRETURN_ulTaskGetIdleRunTimeCounterForCore
+    #define traceRETURN_ulTaskGetIdleRunTimeCounterForCore( ulReturn )
+#endif
+
 #ifndef traceENTER_xTaskGetMPUSettings
     #define traceENTER_xTaskGetMPUSettings( xTask )
 #endif
@@ -2578,6 +3128,14 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+#ifndef configUSE_64_BIT_RUN_TIME_COUNTER
+    #define configUSE_64_BIT_RUN_TIME_COUNTER    0
+#endif
+
+#if ( ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configUSE_64_BIT_RUN_TIME_COUNTER is 1 but configGENERATE_RUN_TIME_STATS is not 1.  Either set configGENERATE_RUN_TIME_STATS to 1 or set configUSE_64_BIT_RUN_TIME_COUNTER to 0 in FreeRTOSConfig.h.
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -2610,6 +3168,78 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+/* Set configUSE_DYNAMIC_TICK to 1 to have the port program the tick interrupt
+ * for the next time the scheduler needs to run - the next task unblock time or
+ * the end of the running task's time slice - rather than generating a tick
+ * interrupt every tick period.  Unlike configUSE_TICKLESS_IDLE ticks are
+ * suppressed whichever task is running. */
+#ifndef configUSE_DYNAMIC_TICK
+    #define configUSE_DYNAMIC_TICK    0
+#endif
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_DYNAMIC_TICK is not supported in SMP FreeRTOS
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE must be 0 when configUSE_DYNAMIC_TICK is 1
+    #endif
+
+    #ifndef portSET_NEXT_TICK_INTERRUPT
+        #error portSET_NEXT_TICK_INTERRUPT must be defined by the port when configUSE_DYNAMIC_TICK is 1
+    #endif
+
+    #ifndef portGET_UNANNOUNCED_TICKS
+        #error portGET_UNANNOUNCED_TICKS must be defined by the port when configUSE_DYNAMIC_TICK is 1
+    #endif
+#endif /* configUSE_DYNAMIC_TICK */
+
+/* When configUSE_64_BIT_RUN_TIME_COUNTER is 1 the kernel extends the 32 bit run
+ * time counter to 64 bits by reading it often enough to see every wrap.  When
+ * ticks are suppressed, set configRUN_TIME_COUNTER_WRAP_TICKS to the number of
+ * ticks in which the 32 bit counter wraps, rounded down, and the kernel will not
+ * suppress more than a quarter of that number of ticks at a time. */
+#if ( ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) && ( ( configUSE_DYNAMIC_TICK == 1 ) || ( configUSE_TICKLESS_IDLE != 0 ) ) )
+    #ifndef configRUN_TIME_COUNTER_WRAP_TICKS
+        #error configRUN_TIME_COUNTER_WRAP_TICKS must be defined when configUSE_64_BIT_RUN_TIME_COUNTER is 1 and ticks are suppressed by configUSE_DYNAMIC_TICK or configUSE_TICKLESS_IDLE.  Set it to the number of ticks in which the 32 bit run time counter wraps.
+    #endif
+
+    #if ( configRUN_TIME_COUNTER_WRAP_TICKS < 4 )
+        #error configRUN_TIME_COUNTER_WRAP_TICKS must be at least 4
+    #endif
+#endif
+
+#ifndef configUSE_TIMING_WHEEL_DELAY_LIST
+    #define configUSE_TIMING_WHEEL_DELAY_LIST    0
+#endif
+
+#if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
+
+/* The delayed task wheel has configTIMING_WHEEL_LEVELS levels, each of which
+ * has ( 1 << configTIMING_WHEEL_BITS_PER_LEVEL ) buckets. */
+    #ifndef configTIMING_WHEEL_BITS_PER_LEVEL
+        #define configTIMING_WHEEL_BITS_PER_LEVEL    5
+    #endif
+
+    #ifndef configTIMING_WHEEL_LEVELS
+        #define configTIMING_WHEEL_LEVELS    3
+    #endif
+
+    #if ( ( configTIMING_WHEEL_BITS_PER_LEVEL < 1 ) || ( configTIMING_WHEEL_LEVELS < 1 ) )
+        #error configTIMING_WHEEL_BITS_PER_LEVEL and configTIMING_WHEEL_LEVELS must both be at least 1
+    #endif
+
+    #if ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) && ( ( configTIMING_WHEEL_BITS_PER_LEVEL * configTIMING_WHEEL_LEVELS ) >= 16 ) )
+        #error configTIMING_WHEEL_BITS_PER_LEVEL * configTIMING_WHEEL_LEVELS must be less than the number of bits in TickType_t
+    #endif
+
+    #if ( ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_32_BITS ) && ( ( configTIMING_WHEEL_BITS_PER_LEVEL * configTIMING_WHEEL_LEVELS ) >= 32 ) )
+        #error configTIMING_WHEEL_BITS_PER_LEVEL * configTIMING_WHEEL_LEVELS must be less than the number of bits in TickType_t
+    #endif
+
+#endif /* configUSE_TIMING_WHEEL_DELAY_LIST */
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -2626,6 +3256,38 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+/* Set configUSE_QUEUE_ZERO_COPY to 1 to include xQueueReserveSend(),
+ * xQueueCommitSend(), xQueuePeekReserve() and xQueueReleaseReceive(), which
+ * let a task write an item into, or read an item from, the queue storage area
+ * directly instead of copying it. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+/* Set configUSE_QUEUE_BATCH_TRANSFERS to 1 to include uxQueueSendMultiple(),
+ * uxQueueReceiveMultiple() and their FromISR() versions, which move several
+ * items to or from a queue in a single critical section. */
+#ifndef configUSE_QUEUE_BATCH_TRANSFERS
+    #define configUSE_QUEUE_BATCH_TRANSFERS    0
+#endif
+
+/* Set configUSE_QUEUE_SPSC to 1 to include xQueueCreateSPSC(), which creates
+ * queues for a single sending and a single receiving task or interrupt.  Items
+ * are passed without a critical section, and blocked tasks are unblocked with
+ * direct to task notifications.  SMP ports must implement portMEMORY_BARRIER()
+ * as a hardware memory barrier. */
+#ifndef configUSE_QUEUE_SPSC
+    #define configUSE_QUEUE_SPSC    0
+#endif
+
+/* The index of the direct to task notification that a task blocked on an SPSC
+ * queue waits on.  The sending and receiving tasks must not use that index for
+ * anything else, so set it to an index the application does not use when
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES is greater than 1. */
+#ifndef configQUEUE_SPSC_NOTIFICATION_INDEX
+    #define configQUEUE_SPSC_NOTIFICATION_INDEX    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2650,6 +3312,10 @@
     #define configUSE_STATS_FORMATTING_FUNCTIONS    0
 #endif
 
+#ifndef configUSE_STATS_ENCODING_FUNCTIONS
+    #define configUSE_STATS_ENCODING_FUNCTIONS    0
+#endif
+
 #ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
     #define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
 #endif
@@ -2674,6 +3340,64 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+/* Set configUSE_TASK_SELECTION_BITMAP to 1 to have the generic (not port
+ * optimised) scheduler track ready priorities in a two level bitmap, making
+ * task selection O(1) regardless of configMAX_PRIORITIES. */
+#ifndef configUSE_TASK_SELECTION_BITMAP
+    #define configUSE_TASK_SELECTION_BITMAP    0
+#endif
+
+#if ( configUSE_TASK_SELECTION_BITMAP == 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        #error configUSE_TASK_SELECTION_BITMAP requires configUSE_PORT_OPTIMISED_TASK_SELECTION to be 0
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_TASK_SELECTION_BITMAP is not supported in SMP FreeRTOS
+    #endif
+
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configMAX_PRIORITIES cannot exceed 1024 when configUSE_TASK_SELECTION_BITMAP is 1
+    #endif
+#endif
+
+/* Set configUSE_EDF_SCHEDULING to 1 to schedule the tasks that run at
+ * configEDF_PRIORITY earliest deadline first rather than round robin. */
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #ifndef configEDF_PRIORITY
+        #define configEDF_PRIORITY    ( configMAX_PRIORITIES - 1 )
+    #endif
+
+    #if ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_EDF_SCHEDULING is not supported in SMP FreeRTOS
+    #endif
+#endif
+
+/* Set configUSE_TASK_BUDGETS to 1 to allow the number of ticks a task may
+ * spend in the Running state in each period to be limited. */
+#ifndef configUSE_TASK_BUDGETS
+    #define configUSE_TASK_BUDGETS    0
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_TASK_BUDGETS != 0 ) )
+    #error configUSE_TASK_BUDGETS is not supported in SMP FreeRTOS
+#endif
+
+/* Set configUSE_FAST_TICK_CATCH_UP to 1 to have xTaskResumeAll() and
+ * xTaskCatchUpTicks() move the tick count directly to each tick at which a
+ * task is due to unblock, rather than processing every pended tick in turn. */
+#ifndef configUSE_FAST_TICK_CATCH_UP
+    #define configUSE_FAST_TICK_CATCH_UP    0
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -2732,6 +3456,10 @@
     #endif
 #endif
 
+#if ( ( configUSE_STATS_ENCODING_FUNCTIONS == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+    #error configUSE_STATS_ENCODING_FUNCTIONS is 1 but configUSE_TRACE_FACILITY is not 1.  The encoding functions use uxTaskGetSystemState().
+#endif
+
 #ifndef configSTATS_BUFFER_MAX_LENGTH
     #define configSTATS_BUFFER_MAX_LENGTH    0xFFFF
 #endif
@@ -2743,11 +3471,21 @@
     #define configSTACK_DEPTH_TYPE    uint16_t
 #endif
 
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+
+/* The run time counters hold the extended 64 bit counter value, so their type
+ * cannot be overridden. */
+    #ifdef configRUN_TIME_COUNTER_TYPE
+        #error configRUN_TIME_COUNTER_TYPE must not be defined when configUSE_64_BIT_RUN_TIME_COUNTER is 1, as the run time counters are then always 64 bits wide.  Remove configRUN_TIME_COUNTER_TYPE from FreeRTOSConfig.h.
+    #endif
+
+    #define configRUN_TIME_COUNTER_TYPE    uint64_t
+#endif
+
 #ifndef configRUN_TIME_COUNTER_TYPE
 
 /* Defaults to uint32_t for backward compatibility, but can be overridden in
  * FreeRTOSConfig.h if uint32_t is too restrictive. */
-
     #define configRUN_TIME_COUNTER_TYPE    uint32_t
 #endif
 
@@ -2768,6 +3506,54 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if ( ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH < 1 )
+    #error configMAX_PRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
+#if ( ( configUSE_ADAPTIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use adaptive mutexes
+#endif
+
+#if ( ( configUSE_ADAPTIVE_MUTEXES == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_ADAPTIVE_MUTEXES is only supported when configNUMBER_OF_CORES is greater than 1
+#endif
+
+#if ( ( configUSE_MUTEX_FAST_PATH == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use the mutex fast path
+#endif
+
+#if ( ( configTCB_CACHE_LINE_SIZE & ( configTCB_CACHE_LINE_SIZE - 1 ) ) != 0 )
+    #error configTCB_CACHE_LINE_SIZE must be 0 or a power of 2
+#endif
+
+#if ( ( configUSE_SKIP_LISTS == 1 ) && ( configSKIP_LIST_LEVELS < 1 ) )
+    #error configSKIP_LIST_LEVELS must be at least 1 when configUSE_SKIP_LISTS is 1
+#endif
+
+#if ( ( configUSE_RWLOCKS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use reader-writer locks
+#endif
+
+#if ( ( configUSE_QUEUE_SPSC == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use SPSC queues
+#endif
+
+#if ( ( configUSE_QUEUE_SPSC == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to use SPSC queues
+#endif
+
+#if ( ( configUSE_QUEUE_SPSC == 1 ) && ( ( configQUEUE_SPSC_NOTIFICATION_INDEX < 0 ) || ( configQUEUE_SPSC_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES ) ) )
+    #error configQUEUE_SPSC_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
 #if ( ( configRUN_MULTIPLE_PRIORITIES == 0 ) && ( configUSE_TASK_PREEMPTION_DISABLE != 0 ) )
     #error configRUN_MULTIPLE_PRIORITIES must be set to 1 to use task preemption disable
 #endif
@@ -2784,6 +3570,14 @@
     #error configUSE_CORE_AFFINITY is not supported in single core FreeRTOS
 #endif
 
+#if ( ( configUSE_CORE_AFFINITY == 0 ) && ( configUSE_PER_CORE_READY_LISTS != 0 ) )
+    #error configUSE_CORE_AFFINITY must be set to 1 to use per core ready lists
+#endif
+
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_GRANULAR_LOCKS != 0 ) )
+    #error configUSE_GRANULAR_LOCKS is not supported in single core FreeRTOS
+#endif
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) )
     #error configUSE_PORT_OPTIMISED_TASK_SELECTION is not supported in SMP FreeRTOS
 #endif
@@ -2946,7 +3740,9 @@
  * tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE is only true if it is possible for a
  * task to be created using either statically or dynamically allocated RAM.  Note
  * that if portUSING_MPU_WRAPPERS is 1 then a protected task can be created with
- * a statically allocated stack and a dynamically allocated TCB.
+ * a statically allocated stack and a dynamically allocated TCB.  Likewise, if
+ * configUSE_TASK_BATCH_CREATION is 1 then tasks created by xTaskCreateBatch()
+ * share a single allocation that must not be freed when one of them is deleted.
  *
  * The following table lists various combinations of portUSING_MPU_WRAPPERS,
  * configSUPPORT_DYNAMIC_ALLOCATION and configSUPPORT_STATIC_ALLOCATION and
@@ -2976,7 +3772,8 @@
  */
 #define tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE                                                                                     \
     ( ( ( portUSING_MPU_WRAPPERS == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) || \
-      ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) )
+      ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) ||                                             \
+      ( ( configUSE_TASK_BATCH_CREATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) )
 
 /*
  * In line with software engineering best practice, FreeRTOS implements a strict
@@ -2994,7 +3791,12 @@ struct xSTATIC_LIST_ITEM
         TickType_t xDummy1;
     #endif
     TickType_t xDummy2;
-    void * pvDummy3[ 4 ];
+    void * pvDummy3[ 2 ];
+    #if ( configUSE_SKIP_LISTS == 1 )
+        void * pvDummy5[ 2 * configSKIP_LIST_LEVELS ];
+        UBaseType_t uxDummy6;
+    #endif
+    void * pvDummy7[ 2 ];
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy4;
     #endif
@@ -3010,6 +3812,9 @@ typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
         #endif
         TickType_t xDummy2;
         void * pvDummy3[ 2 ];
+        #if ( configUSE_SKIP_LISTS == 1 )
+            void * pvDummy5[ 2 * configSKIP_LIST_LEVELS ];
+        #endif
     };
     typedef struct xSTATIC_MINI_LIST_ITEM StaticMiniListItem_t;
 #else /* if ( configUSE_MINI_LIST_ITEM == 1 ) */
@@ -3025,6 +3830,9 @@ typedef struct xSTATIC_LIST
     UBaseType_t uxDummy2;
     void * pvDummy3;
     StaticMiniListItem_t xDummy4;
+    #if ( configUSE_SKIP_LISTS == 1 )
+        UBaseType_t uxDummy6;
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy5;
     #endif
@@ -3043,6 +3851,60 @@ typedef struct xSTATIC_LIST
  * are set.  Its contents are somewhat obfuscated in the hope users will
  * recognise that it would be unwise to make direct use of the structure members.
  */
+#if ( configTCB_CACHE_LINE_SIZE > 0 )
+
+/*
+ * The members that are grouped at the start of the TCB when
+ * configTCB_CACHE_LINE_SIZE is not 0, followed by a marker that gives their
+ * combined size.  Used to size the padding that starts the remaining members
+ * of the TCB on a cache line boundary.
+ */
+    struct xSTATIC_TCB_HOT_MEMBERS
+    {
+        void * pxDummy1;
+        #if ( portUSING_MPU_WRAPPERS == 1 )
+            xMPU_SETTINGS xDummy2;
+        #endif
+        #if ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 1 )
+            UBaseType_t uxDummy26;
+        #endif
+        StaticListItem_t xDummy3[ 2 ];
+        UBaseType_t uxDummy5;
+        void * pxDummy6;
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xDummy23;
+            UBaseType_t uxDummy24;
+        #endif
+        #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+            BaseType_t xDummy25;
+        #endif
+        #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            void * pxDummy8;
+        #endif
+        #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            UBaseType_t uxDummy9;
+        #endif
+        #if ( configUSE_MUTEXES == 1 )
+            UBaseType_t uxDummy12[ 2 ];
+        #endif
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulDummy16;
+        #endif
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+            TickType_t xDummy28;
+            BaseType_t xDummy29;
+        #endif
+        uint8_t ucDummyEnd;
+    };
+
+/* No padding is needed when the grouped members already fill a whole number
+ * of cache lines, in which case the padding array has zero length.  Zero
+ * length arrays are an extension to ISO C that GCC and Clang accept. */
+    #define tskTCB_CACHE_LINE_PADDING                                                                                              \
+        ( ( configTCB_CACHE_LINE_SIZE - ( offsetof( struct xSTATIC_TCB_HOT_MEMBERS, ucDummyEnd ) % configTCB_CACHE_LINE_SIZE ) ) % \
+          configTCB_CACHE_LINE_SIZE )
+#endif /* configTCB_CACHE_LINE_SIZE */
+
 typedef struct xSTATIC_TCB
 {
     void * pxDummy1;
@@ -3059,20 +3921,42 @@ typedef struct xSTATIC_TCB
         BaseType_t xDummy23;
         UBaseType_t uxDummy24;
     #endif
+    #if ( configTCB_CACHE_LINE_SIZE > 0 )
+        #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+            BaseType_t xDummy25;
+        #endif
+        #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            void * pxDummy8;
+        #endif
+        #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            UBaseType_t uxDummy9;
+        #endif
+        #if ( configUSE_MUTEXES == 1 )
+            UBaseType_t uxDummy12[ 2 ];
+        #endif
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulDummy16;
+        #endif
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+            TickType_t xDummy28;
+            BaseType_t xDummy29;
+        #endif
+        uint8_t ucDummy35[ tskTCB_CACHE_LINE_PADDING ];
+    #endif
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
-    #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+    #if ( ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         BaseType_t xDummy25;
     #endif
-    #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+    #if ( ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         void * pxDummy8;
     #endif
-    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    #if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         UBaseType_t uxDummy9;
     #endif
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy10[ 2 ];
     #endif
-    #if ( configUSE_MUTEXES == 1 )
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         UBaseType_t uxDummy12[ 2 ];
     #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
@@ -3081,7 +3965,7 @@ typedef struct xSTATIC_TCB
     #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
         void * pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
@@ -3101,6 +3985,28 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_TASK_NAME_INDEX == 1 )
+        void * pxDummy27;
+    #endif
+    #if ( ( configUSE_EDF_SCHEDULING == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
+        TickType_t xDummy28;
+        BaseType_t xDummy29;
+    #endif
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        TickType_t xDummy30[ 4 ];
+    #endif
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+        void * pxDummy31;
+    #endif
+    #if ( configUSE_TASK_SNAPSHOTS == 1 )
+        UBaseType_t uxDummy32;
+    #endif
+    #if ( ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+        configRUN_TIME_COUNTER_TYPE ulDummy33[ configNUMBER_OF_CORES ];
+    #endif
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        void * pvDummy34;
+    #endif
 } StaticTask_t;
 
 /*
@@ -3143,8 +4049,38 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy10;
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy11;
+    #endif
+
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        uint32_t ulDummy12[ 2 ];
+    #endif
+
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        uint32_t ulDummy13;
+    #endif
+
+    #if ( configUSE_RWLOCKS == 1 )
+        uint8_t ucDummy14;
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy15;
+    #endif
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+        void * pvDummy16[ 2 ];
+        uint8_t ucDummy17;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
+typedef StaticQueue_t StaticRWLock_t;
 
 /*
  * In line with software engineering best practice, especially when supplying a
@@ -3172,6 +4108,10 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy5;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -3226,6 +4166,9 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy6;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -147,6 +147,11 @@ struct xLIST_ITEM
     configLIST_VOLATILE TickType_t xItemValue;          /**< The value being listed.  In most cases this is used to sort the list in ascending order. */
     struct xLIST_ITEM * configLIST_VOLATILE pxNext;     /**< Pointer to the next ListItem_t in the list. */
     struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /**< Pointer to the previous ListItem_t in the list. */
+    #if ( configUSE_SKIP_LISTS == 1 )
+        struct xLIST_ITEM * configLIST_VOLATILE pxSkipNext[ configSKIP_LIST_LEVELS ];     /**< Pointers to the next list item on each express level the item is linked into. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxSkipPrevious[ configSKIP_LIST_LEVELS ]; /**< Pointers to the previous list item on each express level the item is linked into. */
+        UBaseType_t uxSkipLevels;                                                         /**< The number of express levels the item is linked into.  Zero if the item was not inserted by vListInsert(). */
+    #endif
     void * pvOwner;                                     /**< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
     struct xLIST * configLIST_VOLATILE pxContainer;     /**< Pointer to the list in which this list item is placed (if any). */
     listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /**< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -160,6 +165,10 @@ typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint
         configLIST_VOLATILE TickType_t xItemValue;
         struct xLIST_ITEM * configLIST_VOLATILE pxNext;
         struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
+        #if ( configUSE_SKIP_LISTS == 1 )
+            struct xLIST_ITEM * configLIST_VOLATILE pxSkipNext[ configSKIP_LIST_LEVELS ];
+            struct xLIST_ITEM * configLIST_VOLATILE pxSkipPrevious[ configSKIP_LIST_LEVELS ];
+        #endif
     };
     typedef struct xMINI_LIST_ITEM MiniListItem_t;
 #else
@@ -175,6 +184,9 @@ typedef struct xLIST
     volatile UBaseType_t uxNumberOfItems;
     ListItem_t * configLIST_VOLATILE pxIndex; /**< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
     MiniListItem_t xListEnd;                  /**< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+    #if ( configUSE_SKIP_LISTS == 1 )
+        UBaseType_t uxSkipInsertions;         /**< Counts calls to vListInsert() to decide how many express levels each new item is linked into. */
+    #endif
     listSECOND_LIST_INTEGRITY_CHECK_VALUE     /**< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -295,6 +307,34 @@ typedef struct xLIST
         ( pxTCB ) = ( pxConstList )->pxIndex->pvOwner;                                         \
     } while( 0 )
 
+/*
+ * Unlink a list item from the express levels it was linked into by
+ * vListInsert(), and record that an item inserted other than by vListInsert()
+ * is not linked into any express levels.  Used by the remove and insert macros
+ * and functions when configUSE_SKIP_LISTS is 1.
+ */
+#if ( configUSE_SKIP_LISTS == 1 )
+    #define listREMOVE_SKIP_LINKS( pxItemToRemove )                                                \
+    do {                                                                                           \
+        UBaseType_t uxSkipLevel;                                                                   \
+                                                                                                   \
+        for( uxSkipLevel = 0U; uxSkipLevel < ( pxItemToRemove )->uxSkipLevels; uxSkipLevel++ )     \
+        {                                                                                          \
+            ListItem_t * const pxSkipNext = ( pxItemToRemove )->pxSkipNext[ uxSkipLevel ];         \
+            ListItem_t * const pxSkipPrevious = ( pxItemToRemove )->pxSkipPrevious[ uxSkipLevel ]; \
+                                                                                                   \
+            pxSkipNext->pxSkipPrevious[ uxSkipLevel ] = pxSkipPrevious;                            \
+            pxSkipPrevious->pxSkipNext[ uxSkipLevel ] = pxSkipNext;                                \
+        }                                                                                          \
+                                                                                                   \
+        ( pxItemToRemove )->uxSkipLevels = 0U;                                                     \
+    } while( 0 )
+    #define listCLEAR_SKIP_LEVELS( pxListItem )    ( ( pxListItem )->uxSkipLevels = 0U )
+#else
+    #define listREMOVE_SKIP_LINKS( pxItemToRemove )
+    #define listCLEAR_SKIP_LEVELS( pxListItem )
+#endif
+
 /*
  * Version of uxListRemove() that does not return a value.  Provided as a slight
  * optimisation for xTaskIncrementTick() by being inline.
@@ -317,6 +357,7 @@ typedef struct xLIST
          * item. */                                                              \
         List_t * const pxList = ( pxItemToRemove )->pxContainer;                 \
                                                                                  \
+        listREMOVE_SKIP_LINKS( pxItemToRemove );                                 \
         ( pxItemToRemove )->pxNext->pxPrevious = ( pxItemToRemove )->pxPrevious; \
         ( pxItemToRemove )->pxPrevious->pxNext = ( pxItemToRemove )->pxNext;     \
         /* Make sure the index is left pointing to a valid item. */              \
@@ -372,6 +413,7 @@ typedef struct xLIST
                                                              \
         /* Remember which list the item is in. */            \
         ( pxNewListItem )->pxContainer = ( pxList );         \
+        listCLEAR_SKIP_LEVELS( pxNewListItem );              \
                                                              \
         ( ( pxList )->uxNumberOfItems )++;                   \
     } while( 0 )
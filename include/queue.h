@@ -76,6 +76,9 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_CEILING_MUTEX         ( ( uint8_t ) 5U )
+#define queueQUEUE_TYPE_RWLOCK                ( ( uint8_t ) 6U )
+#define queueQUEUE_TYPE_SPSC                  ( ( uint8_t ) 7U )
 
 /**
  * queue. h
@@ -235,6 +238,109 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSC(
+ *                                 UBaseType_t uxQueueLength,
+ *                                 UBaseType_t uxItemSize
+ *                               );
+ * @endcode
+ *
+ * Creates a queue that is only ever written by one task or interrupt and only
+ * ever read by one task or interrupt, and returns a handle by which the queue
+ * can be referenced.  The queue is used through the normal queue API, but
+ * items are sent and received without entering a critical section.  The
+ * kernel is only used when the sender finds the queue full or the receiver
+ * finds the queue empty and has to block, and to unblock that task again.
+ *
+ * configUSE_QUEUE_SPSC must be set to 1 in FreeRTOSConfig.h for this macro to
+ * be available.
+ *
+ * A task blocked on an SPSC queue waits on its direct to task notification
+ * state at index configQUEUE_SPSC_NOTIFICATION_INDEX, which defaults to 0, so
+ * that notification index must not be used for anything else by the sending
+ * or receiving task.  Set configQUEUE_SPSC_NOTIFICATION_INDEX in
+ * FreeRTOSConfig.h to move the queue to an index the application does not
+ * use.  Items can only be sent to the back of an SPSC queue, so
+ * xQueueSendToFront() and xQueueOverwrite() cannot be used.  An SPSC queue
+ * cannot be added to a queue set, and must not be reset while a task other
+ * than the caller could be sending to or receiving from it.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * QueueHandle_t xSampleQueue;
+ *
+ * void vASetupFunction( void )
+ * {
+ *  // Samples are only ever sent by the ADC interrupt and only ever received
+ *  // by the processing task.
+ *  xSampleQueue = xQueueCreateSPSC( 32, sizeof( uint16_t ) );
+ * }
+ *
+ * void vAnADCInterruptHandler( void )
+ * {
+ * uint16_t usSample = usReadADC();
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  xQueueSendFromISR( xSampleQueue, &usSample, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xQueueCreateSPSC xQueueCreateSPSC
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_QUEUE_SPSC == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    #define xQueueCreateSPSC( uxQueueLength, uxItemSize )    xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateSPSCStatic(
+ *                                       UBaseType_t uxQueueLength,
+ *                                       UBaseType_t uxItemSize,
+ *                                       uint8_t *pucQueueStorage,
+ *                                       StaticQueue_t *pxQueueBuffer
+ *                                     );
+ * @endcode
+ *
+ * Creates an SPSC queue, as described for xQueueCreateSPSC(), using memory
+ * provided by the application writer in the same way as xQueueCreateStatic().
+ *
+ * configUSE_QUEUE_SPSC must be set to 1 in FreeRTOSConfig.h for this macro to
+ * be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * ( uxQueueLength * uxItemSize ) bytes long.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If pxQueueBuffer is NULL then NULL is returned.
+ *
+ * \defgroup xQueueCreateSPSCStatic xQueueCreateSPSCStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_QUEUE_SPSC == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    #define xQueueCreateSPSCStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_SPSC ) )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -914,6 +1020,345 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserveSend(
+ *                               QueueHandle_t xQueue,
+ *                               void ** const ppvSlot,
+ *                               TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * Reserve space for an item at the back of a queue, and obtain a pointer to
+ * that space within the queue storage area so the item can be written in place
+ * rather than being built in a separate buffer and copied into the queue.  The
+ * item is added to the queue when xQueueCommitSend() is called.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Only one slot can be reserved in a queue at a time, and nothing else can be
+ * sent to the queue until the slot is committed, so the slot should be
+ * committed as soon as the item has been written.  Tasks that attempt to send
+ * to the queue in the meantime block as if the queue were full.
+ *
+ * @param xQueue The handle to the queue in which space is to be reserved.
+ *
+ * @param ppvSlot Set to point to the reserved space, which is large enough to
+ * hold one item, if the function returns pdPASS.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full or already
+ * have a slot reserved.  The call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if space was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vASensorTask( void *pvParameters )
+ * {
+ * struct AFrame *pxFrame;
+ *
+ *  // Build the frame directly in the queue rather than on the stack.
+ *  if( xQueueReserveSend( xFrameQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      vFillFrame( pxFrame );
+ *      xQueueCommitSend( xFrameQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReserveSend xQueueReserveSend
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReserveSend( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitSend( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Add the item written into the space reserved by xQueueReserveSend() to the
+ * back of the queue, unblocking a task waiting to receive from the queue if
+ * there is one.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue in which space was reserved.
+ *
+ * @return pdPASS if the item was added to the queue, or pdFAIL if no space was
+ * reserved in the queue.
+ *
+ * \defgroup xQueueCommitSend xQueueCommitSend
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommitSend( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekReserve(
+ *                               QueueHandle_t xQueue,
+ *                               void ** const ppvItem,
+ *                               TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * Reserve the item at the front of a queue, and obtain a pointer to the item
+ * within the queue storage area so it can be read in place rather than being
+ * copied into a separate buffer.  The item is removed from the queue when
+ * xQueueReleaseReceive() is called.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Only one item can be reserved in a queue at a time.  Until the item is
+ * released, tasks that attempt to receive from the queue block as if the
+ * queue were empty, and tasks that attempt to send to the front of, or
+ * overwrite, the queue block as if the queue were full.  Items can still be
+ * sent to the back of the queue.
+ *
+ * @param xQueue The handle to the queue from which the item is to be reserved.
+ *
+ * @param ppvItem Set to point to the item if the function returns pdPASS.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to reserve, should the queue be empty or its front item already
+ * be reserved.  The call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if an item was reserved, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAProcessingTask( void *pvParameters )
+ * {
+ * const struct AFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      // Process each frame where it sits in the queue.
+ *      if( xQueuePeekReserve( xFrameQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vProcessFrame( pxFrame );
+ *          xQueueReleaseReceive( xFrameQueue );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueuePeekReserve xQueuePeekReserve
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeekReserve( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReleaseReceive( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Remove the item reserved by xQueuePeekReserve() from the queue, unblocking a
+ * task waiting to send to the queue if there is one.  The pointer obtained
+ * from xQueuePeekReserve() must not be used once the item has been released.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue from which the item was reserved.
+ *
+ * @return pdPASS if the item was removed from the queue, or pdFAIL if no item
+ * was reserved in the queue.
+ *
+ * \defgroup xQueueReleaseReceive xQueueReleaseReceive
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReleaseReceive( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void * const pvItemsToQueue,
+ *                                  const UBaseType_t uxItemCount,
+ *                                  TickType_t xTicksToWait
+ *                                );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in a single operation.
+ * As many of the items as will fit are copied into the queue within one
+ * critical section, and a task waiting to receive from the queue is unblocked
+ * for each item posted.  This is more efficient than calling xQueueSend() once
+ * per item when items are produced in bursts.
+ *
+ * configUSE_QUEUE_BATCH_TRANSFERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * The function only blocks while the queue is completely full, so fewer than
+ * uxItemCount items may be posted.  The caller is responsible for posting any
+ * remaining items.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.  Each item
+ * is the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items in pvItemsToQueue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it be full.  The call
+ * will return immediately if this is set to 0.
+ *
+ * @return The number of items posted, which is 0 if the queue remained full.
+ *
+ * Example usage:
+ * @code{c}
+ * void vASamplingTask( void *pvParameters )
+ * {
+ * uint16_t usSamples[ 16 ];
+ * UBaseType_t uxSent, uxCount;
+ *
+ *  for( ;; )
+ *  {
+ *      uxCount = uxReadSamples( usSamples, 16 );
+ *
+ *      for( uxSent = 0; uxSent < uxCount; )
+ *      {
+ *          uxSent += uxQueueSendMultiple( xSampleQueue, &( usSamples[ uxSent ] ), uxCount - uxSent, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItemsToQueue,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void * const pvBuffer,
+ *                                     const UBaseType_t uxMaxItems,
+ *                                     TickType_t xTicksToWait
+ *                                   );
+ * @endcode
+ *
+ * Receive up to uxMaxItems items from a queue in a single operation.  The items
+ * are removed from the queue in FIFO order within one critical section, and a
+ * task waiting to send to the queue is unblocked for each item removed.
+ *
+ * configUSE_QUEUE_BATCH_TRANSFERS must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * The function only blocks while the queue is empty, and returns as soon as at
+ * least one item is available.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty at the time of the call.
+ * The call will return immediately if this is set to 0.
+ *
+ * @return The number of items received, which is 0 if the queue remained
+ * empty.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                         QueueHandle_t xQueue,
+ *                                         const void * const pvItemsToQueue,
+ *                                         const UBaseType_t uxItemCount,
+ *                                         BaseType_t * const pxHigherPriorityTaskWoken
+ *                                       );
+ * @endcode
+ *
+ * A version of uxQueueSendMultiple() that can be called from an interrupt
+ * service routine.  Items are copied into the queue until it is full.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items.
+ *
+ * @param uxItemCount The number of items in pvItemsToQueue.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If uxQueueSendMultipleFromISR() sets this value to pdTRUE then
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItemsToQueue,
+                                        const UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                            QueueHandle_t xQueue,
+ *                                            void * const pvBuffer,
+ *                                            const UBaseType_t uxMaxItems,
+ *                                            BaseType_t * const pxHigherPriorityTaskWoken
+ *                                          );
+ * @endcode
+ *
+ * A version of uxQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueReceiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if removing the items caused a task
+ * waiting to send to the queue to unblock, and the unblocked task has a
+ * priority higher than the currently running task.  If
+ * uxQueueReceiveMultipleFromISR() sets this value to pdTRUE then a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxMaxItems,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1485,6 +1930,9 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -1494,6 +1942,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+void vQueueGetAdaptiveMutexStats( QueueHandle_t xMutex,
+                                  uint32_t * pulSpinAcquisitions,
+                                  uint32_t * pulBlockingWaits ) PRIVILEGED_FUNCTION;
 
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
@@ -1503,6 +1954,22 @@ BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use the macros defined in rwlock.h instead of
+ * calling these functions directly.
+ */
+QueueHandle_t xQueueCreateRWLock( const BaseType_t xPreferWriters ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateRWLockStatic( const BaseType_t xPreferWriters,
+                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueRWLockTake( QueueHandle_t xRWLock,
+                             TickType_t xTicksToWait,
+                             const BaseType_t xForWriting ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueRWLockGive( QueueHandle_t xRWLock,
+                             const BaseType_t xForWriting ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueRWLockTakeReadFromISR( QueueHandle_t xRWLock ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueRWLockGiveReadFromISR( QueueHandle_t xRWLock,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
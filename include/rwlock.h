@@ -0,0 +1,313 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+#include "queue.h"
+
+/* Reader-writer locks are built on the queue implementation, with tasks
+ * waiting to read held in the queue's list of tasks waiting to receive and
+ * tasks waiting to write held in its list of tasks waiting to send. */
+typedef QueueHandle_t RWLockHandle_t;
+
+/**
+ * rwlock. h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreate( BaseType_t xPreferWriters );
+ * @endcode
+ *
+ * Creates a new reader-writer lock and returns a handle by which the lock can
+ * be referenced.  Any number of tasks can hold the lock for reading at the
+ * same time, but a task that holds the lock for writing holds it exclusively.
+ * configUSE_RWLOCKS must be set to 1 in FreeRTOSConfig.h for this macro to be
+ * available.
+ *
+ * Internally, within the FreeRTOS implementation, reader-writer locks use a
+ * block of memory, in which the lock structure is stored.  If a lock is
+ * created using xRWLockCreate() then the required memory is automatically
+ * dynamically allocated inside the xRWLockCreate() function.  If a lock is
+ * created using xRWLockCreateStatic() then the application writer must
+ * provide the memory.
+ *
+ * A task that holds the lock for writing inherits the priority of any higher
+ * priority task that blocks on the lock, in the same way as the holder of a
+ * mutex.  Tasks that hold the lock for reading do not inherit priorities.
+ *
+ * @param xPreferWriters If pdFALSE then a task can take the lock for reading
+ * whenever it is not held for writing, so a steady stream of readers can keep
+ * writers waiting.  If pdTRUE then a task cannot take the lock for reading
+ * while a task is waiting to write, so a task that already holds the lock for
+ * reading must not take it for reading again.  When the lock is released and
+ * both readers and writers are waiting, the highest priority waiting task is
+ * unblocked, with ties going to the readers unless xPreferWriters is pdTRUE.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If there was not enough heap to allocate the lock's data
+ * structure then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * RWLockHandle_t xConfigLock;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // Create a lock that does not let readers hold off a writer.
+ *  xConfigLock = xRWLockCreate( pdTRUE );
+ *
+ *  if( xConfigLock != NULL )
+ *  {
+ *      // The lock was created successfully and can now be used.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xRWLockCreate xRWLockCreate
+ * \ingroup RWLocks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_RWLOCKS == 1 ) )
+    #define xRWLockCreate( xPreferWriters )    xQueueCreateRWLock( ( xPreferWriters ) )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * RWLockHandle_t xRWLockCreateStatic( BaseType_t xPreferWriters, StaticRWLock_t *pxRWLockBuffer );
+ * @endcode
+ *
+ * Creates a new reader-writer lock using memory provided by the application
+ * writer.  See xRWLockCreate() for a description of the lock.
+ *
+ * @param xPreferWriters See xRWLockCreate().
+ *
+ * @param pxRWLockBuffer Must point to a variable of type StaticRWLock_t, which
+ * will be used to hold the lock's data structure, removing the need for the
+ * memory to be allocated dynamically.
+ *
+ * @return If pxRWLockBuffer is not NULL then a handle to the created lock is
+ * returned.  If pxRWLockBuffer is NULL then NULL is returned.
+ *
+ * \defgroup xRWLockCreateStatic xRWLockCreateStatic
+ * \ingroup RWLocks
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_RWLOCKS == 1 ) )
+    #define xRWLockCreateStatic( xPreferWriters, pxRWLockBuffer )    xQueueCreateRWLockStatic( ( xPreferWriters ), ( pxRWLockBuffer ) )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockTakeRead( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Take a reader-writer lock for reading.  The lock can be held for reading by
+ * any number of tasks at the same time, but not while a task holds it for
+ * writing.
+ *
+ * @param xRWLock A handle to the lock being taken.
+ *
+ * @param xTicksToWait The time in ticks to wait for the lock to become
+ * available for reading.  The macro portTICK_PERIOD_MS can be used to convert
+ * this to a real time.  A block time of zero can be used to poll the lock.
+ *
+ * @return pdTRUE if the lock was taken for reading.  pdFALSE if xTicksToWait
+ * expired without the lock becoming available.
+ *
+ * Example usage:
+ * @code{c}
+ * void vReadingTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      if( xRWLockTakeRead( xConfigLock, pdMS_TO_TICKS( 10 ) ) == pdTRUE )
+ *      {
+ *          // Read the configuration table, which other readers may also be
+ *          // doing at the same time.
+ *
+ *          xRWLockGiveRead( xConfigLock );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xRWLockTakeRead xRWLockTakeRead
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockTakeRead( xRWLock, xTicksToWait )    xQueueRWLockTake( ( xRWLock ), ( xTicksToWait ), pdFALSE )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockTakeWrite( RWLockHandle_t xRWLock, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Take a reader-writer lock for writing.  Only one task can hold the lock for
+ * writing, and not while any task holds it for reading.  The lock is not
+ * recursive, so a task that holds the lock must not take it again.
+ *
+ * @param xRWLock A handle to the lock being taken.
+ *
+ * @param xTicksToWait The time in ticks to wait for the lock to become
+ * available for writing.
+ *
+ * @return pdTRUE if the lock was taken for writing.  pdFALSE if xTicksToWait
+ * expired without the lock becoming available.
+ *
+ * \defgroup xRWLockTakeWrite xRWLockTakeWrite
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockTakeWrite( xRWLock, xTicksToWait )    xQueueRWLockTake( ( xRWLock ), ( xTicksToWait ), pdTRUE )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockGiveRead( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Release a reader-writer lock previously taken for reading.
+ *
+ * @param xRWLock A handle to the lock being released.
+ *
+ * @return pdTRUE if the lock was released.  pdFALSE if the lock was not held
+ * for reading.
+ *
+ * \defgroup xRWLockGiveRead xRWLockGiveRead
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockGiveRead( xRWLock )    xQueueRWLockGive( ( xRWLock ), pdFALSE )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockGiveWrite( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Release a reader-writer lock previously taken for writing.  Must be called
+ * by the task that took the lock.
+ *
+ * @param xRWLock A handle to the lock being released.
+ *
+ * @return pdTRUE if the lock was released.  pdFALSE if the calling task did not
+ * hold the lock for writing.
+ *
+ * \defgroup xRWLockGiveWrite xRWLockGiveWrite
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockGiveWrite( xRWLock )    xQueueRWLockGive( ( xRWLock ), pdTRUE )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockTakeReadFromISR( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * A version of xRWLockTakeRead() that can be called from an interrupt service
+ * routine.  An interrupt cannot block, so the lock is only taken if it is
+ * available for reading when the function is called.  A lock taken with this
+ * function must be released with xRWLockGiveReadFromISR().
+ *
+ * @param xRWLock A handle to the lock being taken.
+ *
+ * @return pdTRUE if the lock was taken for reading, otherwise pdFALSE.
+ *
+ * \defgroup xRWLockTakeReadFromISR xRWLockTakeReadFromISR
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockTakeReadFromISR( xRWLock )    xQueueRWLockTakeReadFromISR( ( xRWLock ) )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * BaseType_t xRWLockGiveReadFromISR( RWLockHandle_t xRWLock, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xRWLockGiveRead() that can be called from an interrupt service
+ * routine.
+ *
+ * @param xRWLock A handle to the lock being released.
+ *
+ * @param pxHigherPriorityTaskWoken xRWLockGiveReadFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if releasing the lock caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xRWLockGiveReadFromISR() sets this value to pdTRUE then a
+ * context switch should be requested before the interrupt is exited.
+ *
+ * @return pdTRUE if the lock was released.  pdFALSE if the lock was not held
+ * for reading.
+ *
+ * \defgroup xRWLockGiveReadFromISR xRWLockGiveReadFromISR
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define xRWLockGiveReadFromISR( xRWLock, pxHigherPriorityTaskWoken )    xQueueRWLockGiveReadFromISR( ( xRWLock ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * UBaseType_t uxRWLockGetReaderCount( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Returns the number of tasks and interrupts that hold the lock for reading.
+ *
+ * \defgroup uxRWLockGetReaderCount uxRWLockGetReaderCount
+ * \ingroup RWLocks
+ */
+#if ( configUSE_RWLOCKS == 1 )
+    #define uxRWLockGetReaderCount( xRWLock )    uxQueueMessagesWaiting( ( QueueHandle_t ) ( xRWLock ) )
+#endif
+
+/**
+ * rwlock. h
+ * @code{c}
+ * void vRWLockDelete( RWLockHandle_t xRWLock );
+ * @endcode
+ *
+ * Delete a reader-writer lock.  Do not delete a lock that is held, or that
+ * tasks are waiting for.
+ *
+ * @param xRWLock A handle to the lock to be deleted.
+ *
+ * \defgroup vRWLockDelete vRWLockDelete
+ * \ingroup RWLocks
+ */
+#define vRWLockDelete( xRWLock )    vQueueDelete( ( QueueHandle_t ) ( xRWLock ) )
+
+#endif /* RWLOCK_H */
@@ -798,6 +798,56 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a new mutex type semaphore instance that uses the immediate priority
+ * ceiling protocol instead of priority inheritance, and returns a handle by
+ * which the new mutex can be referenced.  configUSE_MUTEX_PRIORITY_CEILING
+ * must be set to 1 in FreeRTOSConfig.h for these macros to be available.
+ *
+ * A task that takes a priority ceiling mutex has its priority raised to the
+ * mutex's ceiling priority straight away, whether or not any other task wants
+ * the mutex.  The ceiling must be at least the priority of the highest
+ * priority task that ever takes the mutex, so while the mutex is held no other
+ * task that uses it can preempt the holder.  This bounds the time a task can
+ * be blocked by the mutex to one critical section, avoids chains of inherited
+ * priorities when mutexes are nested, and removes the need to adjust the
+ * holder's priority when the mutex is contended.  As with priority
+ * inheritance, the holder returns to its base priority when it gives back the
+ * last mutex it holds.
+ *
+ * Mutexes created using these macros are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros.  The xSemaphoreTakeRecursive() and
+ * xSemaphoreGiveRecursive() macros must not be used.  Priority ceiling mutexes
+ * cannot be used from within interrupt service routines.
+ *
+ * @param uxCeilingPriority The priority the holder of the mutex runs at.  Must
+ * be less than configMAX_PRIORITIES, and at least the base priority of any task
+ * that takes the mutex.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  Otherwise NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( ( uxCeilingPriority ) )
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -1162,6 +1212,31 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreGetMutexHolderFromISR( xSemaphore )    xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 #endif
 
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreGetAdaptiveMutexStats( SemaphoreHandle_t xMutex, uint32_t * pulSpinAcquisitions, uint32_t * pulBlockingWaits );
+ * @endcode
+ *
+ * Only available when configUSE_ADAPTIVE_MUTEXES is set to 1.
+ *
+ * Retrieve the counters kept by an adaptive mutex, which can be used to tune
+ * configADAPTIVE_MUTEX_SPIN_COUNT.  A task that finds the mutex held by a task
+ * running on another core spins waiting for the mutex to be released before
+ * blocking on it.
+ *
+ * @param xMutex The handle of the mutex being queried.
+ *
+ * @param pulSpinAcquisitions Set to the number of times the mutex was obtained
+ * by spinning rather than blocking.
+ *
+ * @param pulBlockingWaits Set to the number of times a task entered the
+ * Blocked state to wait for the mutex.
+ */
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+    #define vSemaphoreGetAdaptiveMutexStats( xMutex, pulSpinAcquisitions, pulBlockingWaits )    vQueueGetAdaptiveMutexStats( ( xMutex ), ( pulSpinAcquisitions ), ( pulBlockingWaits ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
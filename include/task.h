@@ -155,6 +155,20 @@ typedef struct xTASK_PARAMETERS
     #endif
 } TaskParameters_t;
 
+/*
+ * Parameters required to create one task in a batch created by
+ * xTaskCreateBatch().
+ */
+typedef struct xTASK_BATCH_PARAMETERS
+{
+    TaskFunction_t pxTaskCode;
+    const char * pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    configSTACK_DEPTH_TYPE usStackDepth;
+    void * pvParameters;
+    UBaseType_t uxPriority;
+    TaskHandle_t * pxCreatedTask;
+} TaskBatchParameters_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
  * in the system. */
 typedef struct xTASK_STATUS
@@ -177,6 +191,46 @@ typedef struct xTASK_STATUS
     #endif
 } TaskStatus_t;
 
+/* Used with the uxTaskGetSnapshot() function to return the state of each task
+ * as it was published at the task's most recent context switch. */
+typedef struct xTASK_SNAPSHOT
+{
+    TaskHandle_t xHandle;                         /* The handle of the task to which the rest of the information in the structure relates. */
+    eTaskState eCurrentState;                     /* The state of the task when it was last switched in or out. */
+    UBaseType_t uxCurrentPriority;                /* The priority at which the task was running (may be inherited) when it was last switched in or out. */
+    UBaseType_t uxBasePriority;                   /* The priority to which the task will return if its current priority has been inherited.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /* The total run time allocated to the task up to its most recent context switch.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+    configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space, in words, that has remained for the task at any of its context switches. */
+} TaskSnapshot_t;
+
+/* The size in bytes of each record written by xTaskStatsEncode(), and the
+ * largest frame it can write when encoding up to uxMaxTasks tasks. */
+#define tskSTATS_RECORD_SIZE                   ( ( size_t ) 16U )
+#define tskSTATS_MAX_FRAME_SIZE( uxMaxTasks )    ( tskSTATS_RECORD_SIZE * ( ( size_t ) 1U + ( ( size_t ) 2U * ( size_t ) ( uxMaxTasks ) ) ) )
+
+/* Used by xTaskStatsEncode() to hold the task information being encoded and,
+ * when delta encoding, the information encoded in the previous frame.  Must be
+ * initialised with vTaskStatsEncoderInitialise(); the members are not intended
+ * to be accessed directly. */
+typedef struct xTASK_STATS_ENCODER
+{
+    TaskStatus_t * pxCurrent;
+    TaskStatus_t * pxPrevious;
+    UBaseType_t uxMaxTasks;
+    UBaseType_t uxPreviousTasks;
+    configRUN_TIME_COUNTER_TYPE ulPreviousTotalRunTime;
+    BaseType_t xHavePrevious;
+} TaskStatsEncoder_t;
+
+/* Used with the vTaskGetDeadlineStats() function to report how well the tasks
+ * scheduled earliest deadline first are meeting their deadlines. */
+typedef struct xTASK_DEADLINE_STATS
+{
+    UBaseType_t uxNumberOfDeadlineTasks; /* The number of existing tasks that have been given a deadline. */
+    UBaseType_t uxDeadlinesMet;          /* The number of deadlines that were replaced by vTaskSetDeadline() on or before they expired. */
+    UBaseType_t uxDeadlinesMissed;       /* The number of deadlines that had already expired when they were replaced by vTaskSetDeadline(). */
+} TaskDeadlineStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -249,6 +303,29 @@ typedef enum
     #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
 #endif
 
+/**
+ * task. h
+ *
+ * Macros to mark the start and end of a critical region that only accesses
+ * the members of a single kernel object, such as a queue, that are protected
+ * by the spinlock pxSpinlock.  Interrupts are disabled on the calling core,
+ * but the kernel locks are not taken, so other cores can continue to access
+ * other objects.  Only available when configUSE_GRANULAR_LOCKS is 1.
+ *
+ * An object critical region can be entered from within a kernel critical
+ * region, but a kernel critical region must not be entered from within an
+ * object critical region.
+ *
+ * \defgroup taskENTER_OBJECT_CRITICAL taskENTER_OBJECT_CRITICAL
+ * \ingroup SchedulerControl
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define taskENTER_OBJECT_CRITICAL( pxSpinlock )                vTaskEnterObjectCritical( pxSpinlock )
+    #define taskEXIT_OBJECT_CRITICAL( pxSpinlock )                 vTaskExitObjectCritical( pxSpinlock )
+    #define taskENTER_OBJECT_CRITICAL_FROM_ISR( pxSpinlock )       uxTaskEnterObjectCriticalFromISR( pxSpinlock )
+    #define taskEXIT_OBJECT_CRITICAL_FROM_ISR( pxSpinlock, x )     vTaskExitObjectCriticalFromISR( ( pxSpinlock ), ( x ) )
+#endif
+
 /**
  * task. h
  *
@@ -386,6 +463,123 @@ typedef enum
                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateWithDeadline(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char *pcName,
+ *                            configSTACK_DEPTH_TYPE usStackDepth,
+ *                            void *pvParameters,
+ *                            TickType_t xRelativeDeadline,
+ *                            TaskHandle_t *pxCreatedTask
+ *                        );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Create a new task at priority configEDF_PRIORITY with an absolute deadline
+ * xRelativeDeadline ticks after the current tick count.  Ready tasks at
+ * configEDF_PRIORITY are not time sliced - the one with the earliest deadline
+ * runs, and a task that becomes ready with an earlier deadline than the
+ * running task preempts it.  Tasks that reach configEDF_PRIORITY without a
+ * deadline, for example through priority inheritance, run ahead of all tasks
+ * that have a deadline.
+ *
+ * Deadlines are compared using wrapping tick arithmetic, so they must be less
+ * than half the range of TickType_t away from each other.
+ *
+ * The parameters and return value are the same as for xTaskCreate(), except
+ * the priority is replaced by xRelativeDeadline.
+ *
+ * Example usage:
+ * @code{c}
+ * // A task that must finish each job within 5 ticks of its release.
+ * void vControlTask( void * pvParameters )
+ * {
+ * TickType_t xLastWakeTime = xTaskGetTickCount();
+ *
+ *   for( ;; )
+ *   {
+ *       // Do the work for this period.
+ *       vRunControlLoop();
+ *
+ *       // Wait for the next period, then set the deadline for the next job.
+ *       xTaskDelayUntil( &xLastWakeTime, 10 );
+ *       vTaskSetDeadline( NULL, 5 );
+ *   }
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *   xTaskCreateWithDeadline( vControlTask, "CTRL", STACK_SIZE, NULL, 5, NULL );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateWithDeadline xTaskCreateWithDeadline
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    BaseType_t xTaskCreateWithDeadline( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        void * const pvParameters,
+                                        TickType_t xRelativeDeadline,
+                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateBatch( const TaskBatchParameters_t * const pxTaskDefinitions,
+ *                              UBaseType_t uxNumberOfTasks );
+ * @endcode
+ *
+ * Create several tasks at once.  configUSE_TASK_BATCH_CREATION must be set to
+ * 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * The TCBs and stacks of all the tasks are allocated from the FreeRTOS heap in
+ * a single block, and all the tasks are placed in the ready state from within
+ * a single critical section, so creating n tasks costs one call to
+ * pvPortMalloc() and one critical section instead of 2n and n.  Either all the
+ * tasks are created or none of them are.
+ *
+ * As the tasks share one allocation, the memory used by a task created with
+ * this function is not returned to the heap if the task is deleted.  Use
+ * xTaskCreate() for tasks that are expected to be deleted.
+ *
+ * @param pxTaskDefinitions An array of uxNumberOfTasks TaskBatchParameters_t
+ * structures, each of which describes one task in the same way as the
+ * parameters to xTaskCreate().  pxCreatedTask may be NULL for any task whose
+ * handle is not required.
+ *
+ * @param uxNumberOfTasks The number of entries in pxTaskDefinitions.
+ *
+ * @return pdPASS if all the tasks were created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY and no task was created.
+ *
+ * Example usage:
+ * @code{c}
+ * static const TaskBatchParameters_t xWorkers[] =
+ * {
+ *  { vWorkerTask, "W0", 128, ( void * ) 0, 2, NULL },
+ *  { vWorkerTask, "W1", 128, ( void * ) 1, 2, NULL },
+ *  { vLoggerTask, "LOG", 256, NULL, 1, &xLoggerHandle }
+ * };
+ *
+ * void vStartWorkers( void )
+ * {
+ *  configASSERT( xTaskCreateBatch( xWorkers, 3 ) == pdPASS );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateBatch xTaskCreateBatch
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TASK_BATCH_CREATION == 1 ) )
+    BaseType_t xTaskCreateBatch( const TaskBatchParameters_t * const pxTaskDefinitions,
+                                 UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
     BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -962,6 +1156,150 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetBudget( TaskHandle_t xTask, TickType_t xBudget, TickType_t xPeriod );
+ * @endcode
+ *
+ * configUSE_TASK_BUDGETS must be defined as 1 for this function to be
+ * available.
+ *
+ * Limit the number of ticks a task can spend in the Running state in each
+ * period.  The task running when a tick interrupt occurs is charged for that
+ * tick.  A task that uses its whole budget is moved to the Blocked state
+ * until the start of its next period, at which point its budget is
+ * replenished.
+ *
+ * A task that is blocked for exceeding its budget does not release any
+ * mutexes it holds, so budgets should be large enough to cover any work done
+ * while holding a mutex.
+ *
+ * @param xTask Handle to the task for which the budget is being set.  Passing
+ * a NULL handle results in the budget of the calling task being set.  The idle
+ * task cannot be given a budget.
+ *
+ * @param xBudget The number of ticks the task may run for in each period.
+ * Passing zero removes the task's budget.
+ *
+ * @param xPeriod The length of the period in ticks.  Must not be less than
+ * xBudget.  The first period starts when this function is called.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( TaskHandle_t xBestEffortTask )
+ * {
+ *   // Allow the task at most 2 ticks of processing time every 10 ticks.
+ *   vTaskSetBudget( xBestEffortTask, 2, 10 );
+ * }
+ * @endcode
+ * \defgroup vTaskSetBudget vTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         TickType_t xBudget,
+                         TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetBudgetRemaining( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TASK_BUDGETS must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the budget of the calling task being returned.
+ *
+ * @return The number of ticks the task may still run for in its current
+ * period, or portMAX_DELAY if the task does not have a budget.
+ *
+ * \defgroup xTaskGetBudgetRemaining xTaskGetBudgetRemaining
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+    TickType_t xTaskGetBudgetRemaining( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Give a task a new absolute deadline xRelativeDeadline ticks after the
+ * current tick count.  Setting a new deadline is taken to mean the job that
+ * the previous deadline applied to has completed, so the previous deadline is
+ * counted as met or missed in the statistics returned by
+ * vTaskGetDeadlineStats().
+ *
+ * A deadline only affects scheduling while the task's priority is
+ * configEDF_PRIORITY.  A context switch will occur before the function
+ * returns if the new deadline means another task should now run.
+ *
+ * @param xTask Handle to the task for which the deadline is being set.
+ * Passing a NULL handle results in the deadline of the calling task being set.
+ *
+ * @param xRelativeDeadline The number of ticks from now to the new deadline.
+ *
+ * \defgroup vTaskSetDeadline vTaskSetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetDeadline( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the deadline of the calling task being returned.
+ *
+ * @return The absolute deadline of xTask, or portMAX_DELAY if xTask has never
+ * been given a deadline.
+ *
+ * \defgroup xTaskGetDeadline xTaskGetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    TickType_t xTaskGetDeadline( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetDeadlineStats( TaskDeadlineStats_t *pxDeadlineStats );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Obtain the number of tasks that have a deadline, and how many of their
+ * deadlines have been met and missed.  An application can use these figures
+ * to decide whether further deadline tasks can be admitted.
+ *
+ * @param pxDeadlineStats The structure into which the statistics are written.
+ *
+ * \defgroup vTaskGetDeadlineStats vTaskGetDeadlineStats
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    void vTaskGetDeadlineStats( TaskDeadlineStats_t * pxDeadlineStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1746,7 +2084,10 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION; /*lint !e
  * @endcode
  *
  * NOTE:  This function takes a relatively long time to complete and should be
- * used sparingly.
+ * used sparingly.  If configUSE_TASK_NAME_INDEX is set to 1 in FreeRTOSConfig.h
+ * then task names are held in a hash table, so the function only has to
+ * compare the names of tasks that share a hash bucket with pcNameToQuery, and
+ * does not need to suspend the scheduler.
  *
  * @return The handle of the task that has the human readable name pcNameToQuery.
  * NULL is returned if no matching name is found.  INCLUDE_xTaskGetHandle
@@ -1801,6 +2142,15 @@ TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) PRIVILEGED_FUNCTION; /
  * a value of 1 means 4 bytes) since the task started.  The smaller the returned
  * number the closer the task has come to overflowing its stack.
  *
+ * By default the stack is scanned for the value it was filled with when the
+ * task was created, which takes time proportional to the free stack space.  If
+ * configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is set to 1 the high water mark
+ * is instead recorded each time the task is switched out and returned in
+ * constant time.  That only captures stack usage at context switches, so
+ * configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN can also be set to 1 to extend
+ * the recorded mark with a short word-wise scan that resumes from where the
+ * previous call finished.
+ *
  * uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
  * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
  * user to determine the return type.  It gets around the problem of the value
@@ -2152,6 +2502,40 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetSnapshot( TaskSnapshot_t * const pxSnapshotArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * configUSE_TASK_SNAPSHOTS must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSnapshot() to be available.
+ *
+ * The kernel publishes the state, priority, run time and stack high water
+ * mark of each task into a table every time the task is switched in or out.
+ * uxTaskGetSnapshot() copies that table.  Unlike uxTaskGetSystemState() it
+ * neither suspends the scheduler nor enters a critical section - each entry is
+ * protected by a sequence counter and the copy of an entry is retried if the
+ * entry was updated while it was being read.  Each TaskSnapshot_t is therefore
+ * internally consistent, but different entries may have been published at
+ * slightly different times, and changes that have not yet been followed by a
+ * context switch (for example a call to vTaskPrioritySet()) are not reflected.
+ *
+ * The table holds configTASK_SNAPSHOT_TABLE_SIZE entries.  Tasks created while
+ * the table is full are not reported.
+ *
+ * @param pxSnapshotArray A pointer to an array of TaskSnapshot_t structures.
+ *
+ * @param uxArraySize The number of TaskSnapshot_t structures in the array
+ * pointed to by pxSnapshotArray.
+ *
+ * @return The number of TaskSnapshot_t structures that were populated.
+ */
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+    UBaseType_t uxTaskGetSnapshot( TaskSnapshot_t * const pxSnapshotArray,
+                                   const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2321,6 +2705,80 @@ void vTaskListTasks( char * pcWriteBuffer,
 void vTaskGetRunTimeStatistics( char * pcWriteBuffer,
                                 size_t uxBufferLength ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskStatsEncoderInitialise( TaskStatsEncoder_t *pxEncoder, TaskStatus_t *pxTaskStatusArrays, UBaseType_t uxMaxTasks, BaseType_t xDeltaEncode );
+ * size_t xTaskStatsEncode( TaskStatsEncoder_t *pxEncoder, uint8_t *pucBuffer, size_t xBufferLength );
+ * size_t xTaskStatsEncodeToStreamBuffer( TaskStatsEncoder_t *pxEncoder, StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_ENCODING_FUNCTIONS must both be
+ * defined as 1 for these functions to be available.
+ *
+ * A binary alternative to vTaskListTasks() and vTaskGetRunTimeStatistics()
+ * intended for streaming task statistics off target.  Nothing is allocated
+ * from the heap and nothing is formatted as text - each call writes one frame
+ * of fixed size little endian records that can be decoded on the host, for
+ * example by tools/task_stats_decoder.py.  A frame is either written in full or
+ * not written at all.
+ *
+ * Each frame starts with a frame record that holds the total run time and tick
+ * count, followed by one task record per task that holds the task's number,
+ * state, priorities, run time and stack high water mark.  A name record
+ * precedes the task record of each task the host has not been told the name
+ * of.  Run time counters are encoded modulo 2^32.
+ *
+ * If delta encoding is used, the run times in a frame are relative to the
+ * previous frame written by the same encoder, and name records are only
+ * written for tasks created since that frame, so frames after the first are
+ * smaller and the run time fields do not overflow.  Delta frames can only be
+ * decoded if no frame before them was lost.
+ *
+ * xTaskStatsEncodeToStreamBuffer() writes the frame directly to a stream
+ * buffer, one record at a time, without needing an intermediate buffer.  It
+ * must be the only writer to the stream buffer, and must not be used with a
+ * message buffer.  Use xTaskStatsEncode() and xMessageBufferSend() to send a
+ * frame as a single message.
+ *
+ * @param pxEncoder The encoder to use.  An encoder must only be used by one
+ * task at a time.
+ *
+ * @param pxTaskStatusArrays An array of uxMaxTasks TaskStatus_t structures, or
+ * ( 2 * uxMaxTasks ) structures if xDeltaEncode is pdTRUE, that the encoder
+ * uses to hold task information between calls.
+ *
+ * @param uxMaxTasks The maximum number of tasks that can be encoded.  If there
+ * are more tasks than this in the system nothing is written.
+ *
+ * @param xDeltaEncode Set to pdTRUE to delta encode frames after the first.
+ *
+ * @param pucBuffer The buffer to write the frame to.
+ *
+ * @param xBufferLength The size of pucBuffer in bytes.  A buffer of
+ * tskSTATS_MAX_FRAME_SIZE( uxMaxTasks ) bytes is always large enough.
+ *
+ * @param xStreamBuffer The stream buffer to write the frame to.
+ *
+ * @return The number of bytes written, which is 0 if the frame did not fit in
+ * the space available.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_ENCODING_FUNCTIONS == 1 ) )
+    struct StreamBufferDef_t; /* Declared here so stream_buffer.h need not be included. */
+
+    void vTaskStatsEncoderInitialise( TaskStatsEncoder_t * pxEncoder,
+                                      TaskStatus_t * pxTaskStatusArrays,
+                                      UBaseType_t uxMaxTasks,
+                                      BaseType_t xDeltaEncode ) PRIVILEGED_FUNCTION;
+
+    size_t xTaskStatsEncode( TaskStatsEncoder_t * pxEncoder,
+                             uint8_t * pucBuffer,
+                             size_t xBufferLength ) PRIVILEGED_FUNCTION;
+
+    size_t xTaskStatsEncodeToStreamBuffer( TaskStatsEncoder_t * pxEncoder,
+                                           struct StreamBufferDef_t * xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2459,6 +2917,54 @@ configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask )
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounterForCore( const TaskHandle_t xTask, BaseType_t xCoreID );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID );
+ * @endcode
+ *
+ * configGENERATE_RUN_TIME_STATS and configUSE_64_BIT_RUN_TIME_COUNTER must both
+ * be defined as 1 for these functions to be available.
+ *
+ * When configUSE_64_BIT_RUN_TIME_COUNTER is 1 the run time counters are 64
+ * bits wide, and the kernel extends the value returned by
+ * portGET_RUN_TIME_COUNTER_VALUE() to 64 bits in software by counting the
+ * number of times its low 32 bits wrap.  The extension is shared by all cores.
+ * The run time counter is read on each context switch and each tick interrupt,
+ * and must advance by less than half of its 32 bit range between two reads.
+ * When the tick is suppressed by tickless idle or configUSE_DYNAMIC_TICK,
+ * configRUN_TIME_COUNTER_WRAP_TICKS must be set so the kernel can limit the
+ * number of ticks suppressed.  Percentages then remain correct on long running
+ * systems that use fast run time counters.
+ *
+ * The kernel also records how long each core spent running its idle tasks,
+ * and, in SMP builds, how long each task spent running on each core.
+ * ulTaskGetRunTimeCounterForCore() returns the total execution time of a task
+ * on one core.  ulTaskGetIdleRunTimeCounterForCore() returns the total time
+ * one core spent executing any of the idle tasks, which, unlike
+ * ulTaskGetIdleRunTimeCounter(), is meaningful even when the idle tasks
+ * migrate between cores.
+ *
+ * @param xTask The handle of the task to query.  Passing NULL queries the
+ * calling task.
+ *
+ * @param xCoreID The core to query, from 0 to ( configNUMBER_OF_CORES - 1 ).
+ *
+ * @return The execution time on the given core.  The unit of time is
+ * dependent on the frequency configured using the
+ * portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() and
+ * portGET_RUN_TIME_COUNTER_VALUE() macros.
+ *
+ * \defgroup ulTaskGetRunTimeCounterForCore ulTaskGetRunTimeCounterForCore
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounterForCore( const TaskHandle_t xTask,
+                                                                BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3389,7 +3895,9 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  * vTaskStepTick(), xTaskCatchUpTicks() may move the tick count forward past a
  * time at which a task should be removed from the blocked state.  That means
  * tasks may have to be removed from the blocked state as the tick count is
- * moved.
+ * moved.  If configUSE_FAST_TICK_CATCH_UP is set to 1 then the time taken is
+ * proportional to the number of tasks removed from the blocked state rather
+ * than to xTicksToCatchUp.
  *
  * @param xTicksToCatchUp The number of tick interrupts that have been missed due to
  * interrupts being disabled.  Its value is not computed automatically, so must be
@@ -3431,6 +3939,26 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
+ * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
+ * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Called from the tick interrupt in place of xTaskIncrementTick() when
+ * configUSE_DYNAMIC_TICK is 1.  xTicksElapsed is the number of tick periods
+ * that have passed since the tick count was last updated, which can be zero if
+ * the interrupt occurred early.  The port's portSET_NEXT_TICK_INTERRUPT() is
+ * called to program the next tick interrupt before this function returns.  A
+ * non-zero return value indicates that a context switch is required.
+ *
+ * The port must also implement portGET_UNANNOUNCED_TICKS(), which returns the
+ * number of whole tick periods that have elapsed but have not yet been passed
+ * to xTaskAnnounceTicks().
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    BaseType_t xTaskAnnounceTicks( TickType_t xTicksElapsed ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3576,6 +4104,14 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the calling task to uxCeilingPriority, should the
+ * calling task have a priority less than uxCeilingPriority.  Called when a
+ * priority ceiling mutex is taken.  The raised priority is dropped by
+ * xTaskPriorityDisinherit() once the task holds no more mutexes.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3620,6 +4156,37 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count when a mutex is given
+ * on the fast path, which does not enter a critical section.  Returns pdFALSE,
+ * without changing the count, if the calling task is running at an inherited
+ * priority, in which case the mutex must be given by the path that calls
+ * xTaskPriorityDisinherit().
+ */
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+    BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Record the mutex the calling task is about to block
+ * on, or NULL once it is no longer blocked on a mutex, and return the mutex a
+ * task is blocked on.  Used to walk chains of blocked mutex holders when
+ * configUSE_TRANSITIVE_PRIORITY_INHERITANCE is 1.
+ */
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+    void vTaskSetBlockingMutex( void * pvMutex ) PRIVILEGED_FUNCTION;
+    void * pvTaskGetBlockingMutex( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Returns pdTRUE if xTask is in the Running state on
+ * a core other than the core of the calling task, otherwise pdFALSE.  Used by
+ * adaptive mutexes to decide whether to spin or block.
+ */
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+    BaseType_t xTaskIsRunningOnAnotherCore( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -3668,6 +4235,22 @@ UBaseType_t vTaskEnterCriticalFromISR( void );
  */
 void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/*
+ * For internal use only.  Enter and exit a critical region that is protected
+ * by the spinlock of a single kernel object rather than by the kernel locks.
+ * Use the taskENTER_OBJECT_CRITICAL() family of macros rather than calling
+ * these functions directly.
+ */
+    void vTaskEnterObjectCritical( portSPINLOCK_TYPE * pxSpinlock );
+    void vTaskExitObjectCritical( portSPINLOCK_TYPE * pxSpinlock );
+    UBaseType_t uxTaskEnterObjectCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock );
+    void vTaskExitObjectCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock,
+                                         UBaseType_t uxSavedInterruptStatus );
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 /*
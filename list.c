@@ -76,6 +76,21 @@ void vListInitialise( List_t * const pxList )
     }
     #endif
 
+    /* The list end is the head and tail of every express level. */
+    #if ( configUSE_SKIP_LISTS == 1 )
+    {
+        UBaseType_t uxSkipLevel;
+
+        for( uxSkipLevel = 0U; uxSkipLevel < configSKIP_LIST_LEVELS; uxSkipLevel++ )
+        {
+            pxList->xListEnd.pxSkipNext[ uxSkipLevel ] = ( ListItem_t * ) &( pxList->xListEnd );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+            pxList->xListEnd.pxSkipPrevious[ uxSkipLevel ] = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        }
+
+        pxList->uxSkipInsertions = ( UBaseType_t ) 0U;
+    }
+    #endif
+
     pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
     /* Write known values into the list if
@@ -93,6 +108,7 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 
     /* Make sure the list item is not recorded as being on a list. */
     pxItem->pxContainer = NULL;
+    listCLEAR_SKIP_LEVELS( pxItem );
 
     /* Write known values into the list item if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -130,6 +146,7 @@ void vListInsertEnd( List_t * const pxList,
 
     /* Remember which list the item is in. */
     pxNewListItem->pxContainer = pxList;
+    listCLEAR_SKIP_LEVELS( pxNewListItem );
 
     ( pxList->uxNumberOfItems )++;
 
@@ -143,6 +160,13 @@ void vListInsert( List_t * const pxList,
     ListItem_t * pxIterator;
     const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 
+    #if ( configUSE_SKIP_LISTS == 1 )
+        ListItem_t * pxSkipUpdate[ configSKIP_LIST_LEVELS ];
+        UBaseType_t uxSkipLevel;
+        UBaseType_t uxInsertionCount;
+        UBaseType_t uxNewSkipLevels = 0U;
+    #endif
+
     traceENTER_vListInsert( pxList, pxNewListItem );
 
     /* Only effective when configASSERT() is also defined, these tests may catch
@@ -161,6 +185,8 @@ void vListInsert( List_t * const pxList,
      * first, and the algorithm slightly modified if necessary. */
     if( xValueOfInsertion == portMAX_DELAY )
     {
+        /* Items at the back of the list are found in one step, so they are
+         * not linked into any express levels. */
         pxIterator = pxList->xListEnd.pxPrevious;
     }
     else
@@ -190,7 +216,42 @@ void vListInsert( List_t * const pxList,
         *      configMAX_SYSCALL_INTERRUPT_PRIORITY.
         **********************************************************************/
 
-        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. *//*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
+        pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+        #if ( configUSE_SKIP_LISTS == 1 )
+        {
+            /* Descend through the express levels, sparsest first, to find the
+             * last item on each level whose value is not greater than the
+             * value being inserted.  Each express level is an ordered subset
+             * of the full list, so the walk along the full list below starts
+             * close to the insertion point. */
+            uxSkipLevel = configSKIP_LIST_LEVELS;
+
+            while( uxSkipLevel > 0U )
+            {
+                uxSkipLevel--;
+
+                while( pxIterator->pxSkipNext[ uxSkipLevel ]->xItemValue <= xValueOfInsertion ) /*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
+                {
+                    pxIterator = pxIterator->pxSkipNext[ uxSkipLevel ];
+                }
+
+                pxSkipUpdate[ uxSkipLevel ] = pxIterator;
+            }
+
+            /* One insertion in four is linked into the first express level,
+             * one in sixteen into the first two, and so on.  Deriving the
+             * level from a per list counter keeps the result deterministic. */
+            ( pxList->uxSkipInsertions )++;
+
+            for( uxInsertionCount = pxList->uxSkipInsertions; ( ( uxInsertionCount & 0x03U ) == 0U ) && ( uxNewSkipLevels < configSKIP_LIST_LEVELS ); uxInsertionCount >>= 2 )
+            {
+                uxNewSkipLevels++;
+            }
+        }
+        #endif /* if ( configUSE_SKIP_LISTS == 1 ) */
+
+        for( ; pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
         {
             /* There is nothing to do here, just iterating to the wanted
              * insertion position. */
@@ -202,6 +263,22 @@ void vListInsert( List_t * const pxList,
     pxNewListItem->pxPrevious = pxIterator;
     pxIterator->pxNext = pxNewListItem;
 
+    #if ( configUSE_SKIP_LISTS == 1 )
+    {
+        /* Link the new item into its express levels directly after the last
+         * item on each level that is positioned before it. */
+        for( uxSkipLevel = 0U; uxSkipLevel < uxNewSkipLevels; uxSkipLevel++ )
+        {
+            pxNewListItem->pxSkipNext[ uxSkipLevel ] = pxSkipUpdate[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ];
+            pxNewListItem->pxSkipPrevious[ uxSkipLevel ] = pxSkipUpdate[ uxSkipLevel ];
+            pxNewListItem->pxSkipNext[ uxSkipLevel ]->pxSkipPrevious[ uxSkipLevel ] = pxNewListItem;
+            pxSkipUpdate[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ] = pxNewListItem;
+        }
+
+        pxNewListItem->uxSkipLevels = uxNewSkipLevels;
+    }
+    #endif /* if ( configUSE_SKIP_LISTS == 1 ) */
+
     /* Remember which list the item is in.  This allows fast removal of the
      * item later. */
     pxNewListItem->pxContainer = pxList;
@@ -220,7 +297,7 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 
     traceENTER_uxListRemove( pxItemToRemove );
 
-
+    listREMOVE_SKIP_LINKS( pxItemToRemove );
 
     pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
     pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
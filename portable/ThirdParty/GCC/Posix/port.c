@@ -40,6 +40,10 @@
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
 *
+* When configUSE_DYNAMIC_TICK is 1 the timer is a one-shot POSIX timer
+* (timer_create()/timer_settime()) that the kernel reprograms for the next
+* time the scheduler needs to run, instead of a periodic interval timer.
+*
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
 * deadlocks as the FreeRTOS kernel can switch tasks while they're
@@ -101,11 +105,31 @@ static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
 static volatile BaseType_t uxCriticalNesting;
+
+/* The task the calling thread was created for, or NULL if the calling thread
+ * is not a task thread. */
+__thread void * pvPortCurrentTCB = NULL;
 /*-----------------------------------------------------------*/
 
 static BaseType_t xSchedulerEnd = pdFALSE;
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/* The number of nanoseconds in a tick period. */
+    #define portTICK_PERIOD_NS           ( ( uint64_t ) portTICK_RATE_MICROSECONDS * ( uint64_t ) 1000U )
+
+/* Limits the time the timer is programmed ahead, so the expiry time cannot
+ * overflow.  The timer simply fires early if the kernel asked for longer. */
+    #define portMAX_SUPPRESSED_TICKS     ( ( TickType_t ) configTICK_RATE_HZ * ( TickType_t ) 3600U )
+
+static timer_t xTickTimer;
+
+/* The time at which the last tick passed to xTaskAnnounceTicks() occurred. */
+static volatile uint64_t ullLastTickTimeNs;
+#endif /* configUSE_DYNAMIC_TICK */
+/*-----------------------------------------------------------*/
+
 static void prvSetupSignalsAndSchedulerPolicy( void );
 static void prvSetupTimerInterrupt( void );
 static void * prvWaitForStart( void * pvParams );
@@ -250,18 +274,27 @@ BaseType_t xPortStartScheduler( void )
 
 void vPortEndScheduler( void )
 {
-    struct itimerval itimer;
     struct sigaction sigtick;
     Thread_t * xCurrentThread;
 
     /* Stop the timer and ignore any pending SIGALRMs that would end
      * up running on the main thread when it is resumed. */
-    itimer.it_value.tv_sec = 0;
-    itimer.it_value.tv_usec = 0;
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        ( void ) timer_delete( xTickTimer );
+    }
+    #else
+    {
+        struct itimerval itimer;
 
-    itimer.it_interval.tv_sec = 0;
-    itimer.it_interval.tv_usec = 0;
-    ( void ) setitimer( ITIMER_REAL, &itimer, NULL );
+        itimer.it_value.tv_sec = 0;
+        itimer.it_value.tv_usec = 0;
+
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = 0;
+        ( void ) setitimer( ITIMER_REAL, &itimer, NULL );
+    }
+    #endif /* if ( configUSE_DYNAMIC_TICK == 1 ) */
 
     sigtick.sa_flags = 0;
     sigtick.sa_handler = SIG_IGN;
@@ -272,7 +305,7 @@ void vPortEndScheduler( void )
     xSchedulerEnd = pdTRUE;
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
-    xCurrentThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    xCurrentThread = prvGetThreadFromTask( portGET_CURRENT_TCB() );
     prvSuspendSelf( xCurrentThread );
 }
 /*-----------------------------------------------------------*/
@@ -305,7 +338,7 @@ static void prvPortYieldFromISR( void )
     Thread_t * xThreadToSuspend;
     Thread_t * xThreadToResume;
 
-    xThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    xThreadToSuspend = prvGetThreadFromTask( portGET_CURRENT_TCB() );
 
     vTaskSwitchContext();
 
@@ -366,6 +399,107 @@ static uint64_t prvStartTimeNs;
  * to adjust timing according to full demo requirements */
 /* static uint64_t prvTickCount; */
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/*
+ * Create the one-shot timer that generates the tick interrupts.  The first
+ * interrupt is requested one tick period after the scheduler starts, after
+ * which the kernel calls vPortSetNextTickInterrupt() each time the scheduler
+ * runs.
+ */
+    void prvSetupTimerInterrupt( void )
+    {
+        struct sigevent xEvent;
+        int iRet;
+
+        ( void ) memset( &xEvent, 0, sizeof( xEvent ) );
+        xEvent.sigev_notify = SIGEV_SIGNAL;
+        xEvent.sigev_signo = SIGALRM;
+
+        iRet = timer_create( CLOCK_MONOTONIC, &xEvent, &xTickTimer );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "timer_create", errno );
+        }
+
+        prvStartTimeNs = prvGetTimeNs();
+        ullLastTickTimeNs = prvStartTimeNs;
+
+        vPortSetNextTickInterrupt( 1 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSetNextTickInterrupt( TickType_t xExpectedTicks )
+    {
+        struct itimerspec xTimerSpec;
+        uint64_t ullExpiryTimeNs;
+        int iRet;
+
+        if( xExpectedTicks > portMAX_SUPPRESSED_TICKS )
+        {
+            xExpectedTicks = portMAX_SUPPRESSED_TICKS;
+        }
+
+        /* The expiry time is absolute, and relative to the last announced tick
+         * rather than to now, so the time already spent in the current tick
+         * period is not lost.  An expiry time in the past fires immediately. */
+        ullExpiryTimeNs = ullLastTickTimeNs + ( ( uint64_t ) xExpectedTicks * portTICK_PERIOD_NS );
+
+        xTimerSpec.it_interval.tv_sec = 0;
+        xTimerSpec.it_interval.tv_nsec = 0;
+        xTimerSpec.it_value.tv_sec = ( time_t ) ( ullExpiryTimeNs / ( uint64_t ) 1000000000UL );
+        xTimerSpec.it_value.tv_nsec = ( long ) ( ullExpiryTimeNs % ( uint64_t ) 1000000000UL );
+
+        iRet = timer_settime( xTickTimer, TIMER_ABSTIME, &xTimerSpec, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "timer_settime", errno );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xPortGetUnannouncedTicks( void )
+    {
+        return ( TickType_t ) ( ( prvGetTimeNs() - ullLastTickTimeNs ) / portTICK_PERIOD_NS );
+    }
+/*-----------------------------------------------------------*/
+
+    static void vPortSystemTickHandler( int sig )
+    {
+        Thread_t * pxThreadToSuspend;
+        Thread_t * pxThreadToResume;
+        TickType_t xTicksElapsed;
+
+        ( void ) sig;
+
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+        #if ( configUSE_PREEMPTION == 1 )
+            pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+        #endif
+
+        /* Pass all the tick periods that have elapsed since the last tick
+         * interrupt to the kernel.  This also programs the next interrupt. */
+        xTicksElapsed = xPortGetUnannouncedTicks();
+        ullLastTickTimeNs += ( uint64_t ) xTicksElapsed * portTICK_PERIOD_NS;
+        ( void ) xTaskAnnounceTicks( xTicksElapsed );
+
+        #if ( configUSE_PREEMPTION == 1 )
+            /* Select Next Task. */
+            vTaskSwitchContext();
+
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        #endif
+
+        uxCriticalNesting--;
+    }
+
+#else /* if ( configUSE_DYNAMIC_TICK == 1 ) */
+
 /*
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
@@ -443,6 +577,8 @@ static void vPortSystemTickHandler( int sig )
 
     uxCriticalNesting--;
 }
+
+#endif /* if ( configUSE_DYNAMIC_TICK == 1 ) */
 /*-----------------------------------------------------------*/
 
 void vPortThreadDying( void * pxTaskToDelete,
@@ -474,7 +610,11 @@ static void * prvWaitForStart( void * pvParams )
 
     prvSuspendSelf( pxThread );
 
-    /* Resumed for the first time, unblocks all signals. */
+    /* Resumed for the first time, so this thread's task is now the running
+     * task. */
+    pvPortCurrentTCB = xTaskGetCurrentTaskHandle();
+
+    /* Unblock all signals. */
     uxCriticalNesting = 0;
     vPortEnableInterrupts();
 
@@ -117,6 +117,11 @@ extern void vPortExitCritical( void );
 #define portENTER_CRITICAL()                      vPortEnterCritical()
 #define portEXIT_CRITICAL()                       vPortExitCritical()
 
+/* Each task runs in its own thread, so the thread-local copy of the running
+ * task is set once when the thread starts and never changes. */
+extern __thread void * pvPortCurrentTCB;
+#define portGET_CURRENT_TCB()    ( pvPortCurrentTCB )
+
 /*-----------------------------------------------------------*/
 
 extern void vPortThreadDying( void * pxTaskToDelete,
@@ -130,6 +135,11 @@ extern void vPortCancelThread( void * pxTaskToDelete );
 #define portTASK_FUNCTION( vFunction, pvParameters )               void vFunction( void * pvParameters )
 /*-----------------------------------------------------------*/
 
+#ifndef portFORCE_INLINE
+    #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
+#endif
+/*-----------------------------------------------------------*/
+
 /*
  * Tasks run in their own pthreads and context switches between them
  * are always a full memory barrier. ISRs are emulated as signals
@@ -140,6 +150,12 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  */
 #define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
 
+/* Used by the kernel when configUSE_DYNAMIC_TICK is 1. */
+extern void vPortSetNextTickInterrupt( TickType_t xExpectedTicks );
+extern TickType_t xPortGetUnannouncedTicks( void );
+#define portSET_NEXT_TICK_INTERRUPT( xExpectedTicks )    vPortSetNextTickInterrupt( xExpectedTicks )
+#define portGET_UNANNOUNCED_TICKS()                      xPortGetUnannouncedTicks()
+
 extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
@@ -38,6 +38,10 @@
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+    #include "atomic.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
 #endif
@@ -78,6 +82,39 @@ typedef struct SemaphoreData
     UBaseType_t uxRecursiveCallCount; /**< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
 } SemaphoreData_t;
 
+#if ( configUSE_QUEUE_SPSC == 1 )
+
+/* An SPSC queue is read and written through indices rather than pointers so
+ * the sender and the receiver each own one index and never write the same
+ * member.  Both indices run from 0 to ( 2 * uxLength ) - 1, so a full queue
+ * can be told apart from an empty one without leaving a slot unused. */
+    typedef struct SPSCQueueIndices
+    {
+        volatile UBaseType_t uxWriteIndex; /**< The index of the next slot to write.  Only written by the sender. */
+        volatile UBaseType_t uxReadIndex;  /**< The index of the next slot to read.  Only written by the receiver. */
+    } SPSCQueueIndices_t;
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/* The ceiling priority of a mutex that uses priority inheritance rather than
+ * the priority ceiling protocol.  No task can have this priority. */
+    #define queueNO_PRIORITY_CEILING                ( ( UBaseType_t ) configMAX_PRIORITIES )
+
+    #define queueHAS_PRIORITY_CEILING( pxQueue )    ( ( ( pxQueue )->uxCeilingPriority != queueNO_PRIORITY_CEILING ) ? pdTRUE : pdFALSE )
+#else
+    #define queueHAS_PRIORITY_CEILING( pxQueue )    ( pdFALSE )
+#endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/* When the mutex fast path is used the holder of a mutex, rather than the
+ * count, records whether the mutex is available.  The holder is claimed and
+ * released with atomic operations, so a mutex is taken and given without
+ * entering a critical section unless another task is waiting for it. */
+    #define queueMUTEX_HOLDER( pxQueue )    ( ( void * volatile * ) &( ( pxQueue )->u.xSemaphore.xMutexHolder ) )
+#endif
+
 /* Semaphores do not actually store or copy data, so have an item size of
  * zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
@@ -110,6 +147,9 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     {
         QueuePointers_t xQueue;     /**< Data required exclusively when this structure is used as a queue. */
         SemaphoreData_t xSemaphore; /**< Data required exclusively when this structure is used as a semaphore. */
+        #if ( configUSE_QUEUE_SPSC == 1 )
+            SPSCQueueIndices_t xSPSC; /**< Data required exclusively when this structure is used as an SPSC queue. */
+        #endif
     } u;
 
     List_t xTasksWaitingToSend;             /**< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
@@ -134,6 +174,37 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xSpinlock; /**< Protects the members of the queue when configUSE_GRANULAR_LOCKS is 1. */
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority; /**< The priority the holder of the mutex is raised to, or queueNO_PRIORITY_CEILING if the mutex uses priority inheritance. */
+    #endif
+
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        uint32_t ulSpinAcquisitions; /**< The number of times the mutex was obtained after spinning while its holder ran on another core. */
+        uint32_t ulBlockingWaits;    /**< The number of times a task blocked waiting for the mutex. */
+    #endif
+
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        volatile uint32_t ulMutexContended; /**< Set when a task blocks on the mutex, so the holder gives the mutex on the slow path and unblocks the task. */
+    #endif
+
+    #if ( configUSE_RWLOCKS == 1 )
+        uint8_t ucRWLockPreferWriters; /**< Set to pdTRUE if tasks cannot take the reader-writer lock for reading while a task is waiting to write. */
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucReservations; /**< Records whether a slot is reserved for sending, and whether the item at the head of the queue is reserved for receiving. */
+    #endif
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+        TaskHandle_t volatile xTaskWaitingToSendSPSC;    /**< The task blocked waiting for space in an SPSC queue, or NULL.  Only written by the sending task. */
+        TaskHandle_t volatile xTaskWaitingToReceiveSPSC; /**< The task blocked waiting for an item in an SPSC queue, or NULL.  Only written by the receiving task. */
+        uint8_t ucIsSPSC;                                /**< Set to pdTRUE if the queue was created by xQueueCreateSPSC(). */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -180,18 +251,21 @@ typedef xQUEUE Queue_t;
 static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any data in a queue.
+ * Uses a critical section to determine if there is any data in a queue that
+ * can be received.
  *
  * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
  */
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueEmpty( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * Uses a critical section to determine if there is any space in a queue for
+ * an item to be written at xPosition.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( Queue_t * const pxQueue,
+                                  const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -216,6 +290,135 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_SPSC == 1 )
+
+/*
+ * Returns the number of items in an SPSC queue.
+ */
+    static UBaseType_t prvSPSCItemsWaiting( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a pointer to the storage slot used by an SPSC queue index, and the
+ * index that follows uxIndex.
+ */
+    static int8_t * prvSPSCSlot( const Queue_t * const pxQueue,
+                                 UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvSPSCNextIndex( const Queue_t * const pxQueue,
+                                         const UBaseType_t uxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write an item to, or read an item from, an SPSC queue without blocking and
+ * without notifying the other side.  Return pdPASS if successful.
+ */
+    static BaseType_t prvWriteSPSC( Queue_t * const pxQueue,
+                                    const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReadSPSC( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on its notification state until the other side of
+ * an SPSC queue notifies it, or xTicksToWait expires.  Returns without
+ * blocking if the queue no longer needs to be waited for.
+ */
+    static void prvWaitSPSC( Queue_t * const pxQueue,
+                             TaskHandle_t volatile * const pxWaitingTask,
+                             const BaseType_t xForSpace,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item to the back of an SPSC queue if there is space, then notifies
+ * the receiving task if it is blocked.  Must only be called by the sender.
+ * Returns pdPASS if the item was sent.
+ */
+    static BaseType_t prvSendSPSC( Queue_t * const pxQueue,
+                                   const void * const pvItemToQueue,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSendSPSCFromISR( Queue_t * const pxQueue,
+                                          const void * const pvItemToQueue,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the item at the front of an SPSC queue, and unless xJustPeeking is
+ * pdTRUE removes it and notifies the sending task if it is blocked.  Must only
+ * be called by the receiver.  Returns pdPASS if an item was received.
+ */
+    static BaseType_t prvReceiveSPSC( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReceiveSPSCFromISR( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             BaseType_t * const pxHigherPriorityTaskWoken,
+                                             const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_QUEUE_SPSC */
+
+#if ( configUSE_QUEUE_BATCH_TRANSFERS == 1 )
+
+/*
+ * Copies as many of the uxItemCount items at pcItems to the back of a queue as
+ * there is space for, using at most two copies where the items wrap around the
+ * end of the queue storage area.  Returns the number of items copied.
+ */
+    static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                            const int8_t * pcItems,
+                                            const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies up to uxMaxItems items out of a queue into pcBuffer, using at most
+ * two copies where the items wrap around the end of the queue storage area.
+ * Returns the number of items copied.
+ */
+    static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                              int8_t * pcBuffer,
+                                              const UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxMaxTasks tasks from pxEventList, one for each item sent to
+ * or received from the queue.  Returns pdTRUE if an unblocked task has a
+ * priority above that of the calling task.
+ */
+    static BaseType_t prvUnblockTasksForItems( List_t * const pxEventList,
+                                               const UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Notifies the queue set that contains pxQueue, or unblocks tasks waiting to
+ * receive from pxQueue, after uxItemCount items have been sent to it.
+ * Returns pdTRUE if an unblocked task has a priority above that of the
+ * calling task.
+ */
+    static BaseType_t prvNotifyItemsSent( Queue_t * const pxQueue,
+                                          const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/*
+ * Attempt to send to, receive from or peek a queue while only holding the
+ * queue's own spinlock.  This succeeds when the operation completes without
+ * blocking and without needing to unblock a task, otherwise the queue is left
+ * unchanged, pdFALSE is returned, and the caller takes the kernel locks.
+ */
+    static BaseType_t prvSendWithoutKernelLock( Queue_t * const pxQueue,
+                                                const void * pvItemToQueue,
+                                                const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReceiveWithoutKernelLock( Queue_t * const pxQueue,
+                                                   void * const pvBuffer,
+                                                   const BaseType_t xJustPeeking ) PRIVILEGED_FUNCTION;
+
+/*
+ * Enter and exit a critical section from an ISR.  The kernel locks are only
+ * taken if the operation could access a task event list.  pxKernelLocked is
+ * set to indicate whether they were taken, and must be passed to the exit
+ * function.
+ */
+    static UBaseType_t prvEnterQueueCriticalFromISR( Queue_t * const pxQueue,
+                                                     BaseType_t * const pxKernelLocked ) PRIVILEGED_FUNCTION;
+    static void prvExitQueueCriticalFromISR( Queue_t * const pxQueue,
+                                             const BaseType_t xKernelLocked,
+                                             const UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_GRANULAR_LOCKS */
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -246,14 +449,189 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+/*
+ * Raise the holder of pxMutex to the priority of the calling task, then, if
+ * that holder is itself blocked on a mutex, raise the holder of that mutex too,
+ * and so on for up to configMAX_PRIORITY_INHERITANCE_DEPTH holders.  Returns
+ * pdTRUE if the holder of pxMutex inherited the calling task's priority.  Must
+ * be called from a critical section.
+ */
+    static BaseType_t prvInheritThroughMutexChain( const Queue_t * pxMutex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Walk the same chain of mutex holders as prvInheritThroughMutexChain() after
+ * the calling task timed out waiting for pxMutex, dropping each holder back to
+ * the highest priority of the tasks still waiting for the mutex it holds.  Must
+ * be called from a critical section.
+ */
+    static void prvDisinheritThroughMutexChainAfterTimeout( const Queue_t * pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+/*
+ * Spin for up to configADAPTIVE_MUTEX_SPIN_COUNT iterations while pxMutex is
+ * held by a task that is running on another core.  Returns pdTRUE if the mutex
+ * was seen to be released, in which case the caller should attempt to take it
+ * again, or pdFALSE if the caller should block.
+ */
+    static BaseType_t prvSpinWhileMutexHolderRuns( const Queue_t * pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/*
+ * Atomically make the calling task the holder of pxMutex if the mutex has no
+ * holder.  Returns pdTRUE if the calling task is now the holder.
+ */
+    static BaseType_t prvClaimMutex( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give pxMutex, which must be held by the calling task.  Only enters a
+ * critical section if a task is waiting for the mutex or the calling task has
+ * inherited a priority.
+ */
+    static BaseType_t prvGiveMutex( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_RWLOCKS == 1 )
+
+/*
+ * A reader-writer lock is a queue with an item size of zero.  The holder of
+ * the lock for writing is stored as the mutex holder, so it can inherit
+ * priorities, and uxMessagesWaiting is the number of readers that hold the
+ * lock.  Tasks waiting to read block on xTasksWaitingToReceive and tasks
+ * waiting to write block on xTasksWaitingToSend.
+ */
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue,
+                                     const BaseType_t xPreferWriters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the lock can be taken for writing, if xForWriting is
+ * pdTRUE, or for reading, if xForWriting is pdFALSE.  Must be called from a
+ * critical section.
+ */
+    static BaseType_t prvRWLockIsAvailable( const Queue_t * const pxRWLock,
+                                            const BaseType_t xForWriting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task waiting for the lock,
+ * whether to read or to write.
+ */
+    static UBaseType_t prvGetRWLockDisinheritPriority( const Queue_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock either one task waiting to write or all the tasks waiting to read,
+ * whichever can now take the lock.  Returns pdTRUE if an unblocked task has a
+ * higher priority than the calling task.  Must be called from a critical
+ * section with the queue unlocked.
+ */
+    static BaseType_t prvRWLockUnblockWaiters( Queue_t * const pxRWLock ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
+/*
+ * Critical sections that access a queue.  When configUSE_GRANULAR_LOCKS is 1
+ * the queue members are protected by the queue's own spinlock.  The kernel
+ * locks are always taken before the queue spinlock, never after it, so
+ * queueENTER_CRITICAL() takes both and can be used around code that accesses
+ * the event lists or the state of a task.  queueENTER_OBJECT_CRITICAL() takes
+ * only the queue spinlock and must not be used around such code.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define queueENTER_CRITICAL( pxQueue )                                    \
+    do {                                                                      \
+        taskENTER_CRITICAL();                                                 \
+        taskENTER_OBJECT_CRITICAL( &( ( pxQueue )->xSpinlock ) );             \
+    } while( 0 )
+    #define queueEXIT_CRITICAL( pxQueue )                                     \
+    do {                                                                      \
+        taskEXIT_OBJECT_CRITICAL( &( ( pxQueue )->xSpinlock ) );              \
+        taskEXIT_CRITICAL();                                                  \
+    } while( 0 )
+    #define queueENTER_OBJECT_CRITICAL( pxQueue )                             taskENTER_OBJECT_CRITICAL( &( ( pxQueue )->xSpinlock ) )
+    #define queueEXIT_OBJECT_CRITICAL( pxQueue )                              taskEXIT_OBJECT_CRITICAL( &( ( pxQueue )->xSpinlock ) )
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue, pxKernelLocked )           prvEnterQueueCriticalFromISR( ( pxQueue ), ( pxKernelLocked ) )
+    #define queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, x )          prvExitQueueCriticalFromISR( ( pxQueue ), ( xKernelLocked ), ( x ) )
+    #define queueENTER_OBJECT_CRITICAL_FROM_ISR( pxQueue )                    taskENTER_OBJECT_CRITICAL_FROM_ISR( &( ( pxQueue )->xSpinlock ) )
+    #define queueEXIT_OBJECT_CRITICAL_FROM_ISR( pxQueue, x )                  taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( ( pxQueue )->xSpinlock ), ( x ) )
+#else
+    #define queueENTER_CRITICAL( pxQueue )                                    taskENTER_CRITICAL()
+    #define queueEXIT_CRITICAL( pxQueue )                                     taskEXIT_CRITICAL()
+    #define queueENTER_OBJECT_CRITICAL( pxQueue )                             taskENTER_CRITICAL()
+    #define queueEXIT_OBJECT_CRITICAL( pxQueue )                              taskEXIT_CRITICAL()
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue, pxKernelLocked )           taskENTER_CRITICAL_FROM_ISR()
+    #define queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, x )          taskEXIT_CRITICAL_FROM_ISR( x )
+    #define queueENTER_OBJECT_CRITICAL_FROM_ISR( pxQueue )                    taskENTER_CRITICAL_FROM_ISR()
+    #define queueEXIT_OBJECT_CRITICAL_FROM_ISR( pxQueue, x )                  taskEXIT_CRITICAL_FROM_ISR( x )
+#endif /* configUSE_GRANULAR_LOCKS */
+
+/*
+ * Evaluates to pdTRUE if a task is not part way through blocking on the
+ * queue, that is, the queue is not locked by prvLockQueue().
+ */
+#define queueIS_UNLOCKED( pxQueue )    ( ( ( ( pxQueue )->cRxLock == queueUNLOCKED ) && ( ( pxQueue )->cTxLock == queueUNLOCKED ) ) ? pdTRUE : pdFALSE )
+
+/*
+ * Evaluates to pdTRUE if the queue is a member of a queue set.
+ */
+#if ( configUSE_QUEUE_SETS == 1 )
+    #define queueIS_SET_MEMBER( pxQueue )    ( ( ( pxQueue )->pxQueueSetContainer != NULL ) ? pdTRUE : pdFALSE )
+#else
+    #define queueIS_SET_MEMBER( pxQueue )    pdFALSE
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* Bits set in ucReservations while a task holds a slot returned by
+ * xQueueReserveSend(), or an item returned by xQueuePeekReserve(). */
+    #define queueRESERVED_FOR_SEND       ( ( uint8_t ) 0x01U )
+    #define queueRESERVED_FOR_RECEIVE    ( ( uint8_t ) 0x02U )
+
+/*
+ * Evaluates to pdTRUE if an item cannot be sent to the queue at xPosition
+ * because of a reservation.  Nothing can be sent while a reserved slot is
+ * waiting to be committed, as the item would be queued behind the slot.
+ * Nothing can be written to the front of the queue while the item at the head
+ * of the queue is reserved, as doing so would displace or overwrite the item.
+ */
+    #define queueSEND_IS_RESERVED( pxQueue, xPosition )                                   \
+    ( ( ( ( ( pxQueue )->ucReservations & queueRESERVED_FOR_SEND ) != 0U ) ||             \
+        ( ( ( ( pxQueue )->ucReservations & queueRESERVED_FOR_RECEIVE ) != 0U ) &&        \
+          ( ( xPosition ) != queueSEND_TO_BACK ) ) ) ? pdTRUE : pdFALSE )
+
+/*
+ * Evaluates to pdTRUE if nothing can be received from the queue because the
+ * item at the head of the queue is reserved.
+ */
+    #define queueRECEIVE_IS_RESERVED( pxQueue )    ( ( ( ( pxQueue )->ucReservations & queueRESERVED_FOR_RECEIVE ) != 0U ) ? pdTRUE : pdFALSE )
+#else
+    #define queueSEND_IS_RESERVED( pxQueue, xPosition )    pdFALSE
+    #define queueRECEIVE_IS_RESERVED( pxQueue )            pdFALSE
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+/*
+ * Evaluates to pdTRUE if the queue was created by xQueueCreateSPSC().  Such
+ * queues do not use uxMessagesWaiting, so queueMESSAGES_WAITING() is used
+ * wherever the number of items is read outside of the send and receive paths.
+ */
+#if ( configUSE_QUEUE_SPSC == 1 )
+    #define queueIS_SPSC( pxQueue )             ( ( pxQueue )->ucIsSPSC )
+    #define queueMESSAGES_WAITING( pxQueue )    ( ( queueIS_SPSC( pxQueue ) != pdFALSE ) ? prvSPSCItemsWaiting( pxQueue ) : ( pxQueue )->uxMessagesWaiting )
+#else
+    #define queueIS_SPSC( pxQueue )             pdFALSE
+    #define queueMESSAGES_WAITING( pxQueue )    ( ( pxQueue )->uxMessagesWaiting )
+#endif
+
 /*
  * Macro to mark a queue as locked.  Locking a queue prevents an ISR from
  * accessing the queue event lists.
  */
 #define prvLockQueue( pxQueue )                            \
-    taskENTER_CRITICAL();                                  \
+    queueENTER_CRITICAL( pxQueue );                        \
     {                                                      \
         if( ( pxQueue )->cRxLock == queueUNLOCKED )        \
         {                                                  \
@@ -264,7 +642,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             ( pxQueue )->cTxLock = queueLOCKED_UNMODIFIED; \
         }                                                  \
     }                                                      \
-    taskEXIT_CRITICAL()
+    queueEXIT_CRITICAL( pxQueue )
 
 /*
  * Macro to increment cTxLock member of the queue data structure. It is
@@ -312,7 +690,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         /* Check for multiplication overflow. */
         ( ( SIZE_MAX / pxQueue->uxLength ) >= pxQueue->uxItemSize ) )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
             pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
@@ -321,6 +699,41 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucReservations = 0U;
+            }
+            #endif
+
+            #if ( configUSE_QUEUE_SPSC == 1 )
+            {
+                if( pxQueue->ucIsSPSC != pdFALSE )
+                {
+                    const TaskHandle_t xWaitingTask = pxQueue->xTaskWaitingToSendSPSC;
+
+                    /* Overwrites the pointers set above, which an SPSC queue
+                     * does not use. */
+                    pxQueue->u.xSPSC.uxWriteIndex = ( UBaseType_t ) 0U;
+                    pxQueue->u.xSPSC.uxReadIndex = ( UBaseType_t ) 0U;
+
+                    /* A sending task blocked on a full SPSC queue is not held
+                     * in xTasksWaitingToSend, so notify it directly. */
+                    if( ( xNewQueue == pdFALSE ) && ( xWaitingTask != NULL ) )
+                    {
+                        ( void ) xTaskNotifyIndexed( xWaitingTask, configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SPSC */
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -351,7 +764,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                 vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
     }
     else
     {
@@ -588,6 +1001,34 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        portINIT_SPINLOCK( &( pxNewQueue->xSpinlock ) );
+    }
+    #endif
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( ucQueueType == queueQUEUE_TYPE_SPSC )
+        {
+            /* The indices count up to twice the queue length, and items are
+             * always copied. */
+            configASSERT( uxQueueLength <= ( ( ( UBaseType_t ) ~( UBaseType_t ) 0U ) / ( UBaseType_t ) 2U ) );
+            configASSERT( uxItemSize != ( UBaseType_t ) 0U );
+
+            pxNewQueue->ucIsSPSC = pdTRUE;
+        }
+        else
+        {
+            pxNewQueue->ucIsSPSC = pdFALSE;
+        }
+
+        pxNewQueue->xTaskWaitingToSendSPSC = NULL;
+        pxNewQueue->xTaskWaitingToReceiveSPSC = NULL;
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -622,10 +1063,36 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+            {
+                /* Overwritten if this is a priority ceiling mutex. */
+                pxNewQueue->uxCeilingPriority = queueNO_PRIORITY_CEILING;
+            }
+            #endif
+
+            #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+            {
+                pxNewQueue->ulSpinAcquisitions = 0U;
+                pxNewQueue->ulBlockingWaits = 0U;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
-            /* Start with the semaphore in the expected state. */
-            ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* A mutex without a holder cannot be given, so start with the
+                 * semaphore in the expected state by setting the count
+                 * directly. */
+                pxNewQueue->ulMutexContended = 0U;
+                pxNewQueue->uxMessagesWaiting = ( UBaseType_t ) 1;
+            }
+            #else
+            {
+                /* Start with the semaphore in the expected state. */
+                ( void ) xQueueGenericSend( pxNewQueue, NULL, ( TickType_t ) 0U, queueSEND_TO_BACK );
+            }
+            #endif
         }
         else
         {
@@ -681,6 +1148,69 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateMutexWithCeiling( uxCeilingPriority );
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueGenericCreate( uxMutexLength, uxMutexSize, queueQUEUE_TYPE_CEILING_MUTEX );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxMutexLength = ( UBaseType_t ) 1, uxMutexSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateMutexWithCeilingStatic( uxCeilingPriority, pxStaticQueue );
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueGenericCreateStatic( uxMutexLength, uxMutexSize, NULL, pxStaticQueue, queueQUEUE_TYPE_CEILING_MUTEX );
+        prvInitialiseMutex( ( Queue_t * ) xNewQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -748,6 +1278,39 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+    void vQueueGetAdaptiveMutexStats( QueueHandle_t xMutex,
+                                      uint32_t * pulSpinAcquisitions,
+                                      uint32_t * pulBlockingWaits )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        traceENTER_vQueueGetAdaptiveMutexStats( xMutex, pulSpinAcquisitions, pulBlockingWaits );
+
+        configASSERT( pxMutex );
+        configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        queueENTER_CRITICAL( pxMutex );
+        {
+            if( pulSpinAcquisitions != NULL )
+            {
+                *pulSpinAcquisitions = pxMutex->ulSpinAcquisitions;
+            }
+
+            if( pulBlockingWaits != NULL )
+            {
+                *pulBlockingWaits = pxMutex->ulBlockingWaits;
+            }
+        }
+        queueEXIT_CRITICAL( pxMutex );
+
+        traceRETURN_vQueueGetAdaptiveMutexStats();
+    }
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
     BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -854,386 +1417,461 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configUSE_RWLOCKS == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue,
+                                     const BaseType_t xPreferWriters )
     {
-        QueueHandle_t xHandle = NULL;
-
-        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
-
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        if( pxNewQueue != NULL )
         {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
-
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
-
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
+            /* The lock starts with no writer and no readers.  The queue is not
+             * marked as a mutex, as the count is the number of readers rather
+             * than whether the lock is available. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+            pxNewQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+            pxNewQueue->ucRWLockPreferWriters = ( uint8_t ) ( ( xPreferWriters != pdFALSE ) ? pdTRUE : pdFALSE );
         }
         else
         {
-            configASSERT( xHandle );
             mtCOVERAGE_TEST_MARKER();
         }
-
-        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
-
-        return xHandle;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_RWLOCKS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( ( configUSE_RWLOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    QueueHandle_t xQueueCreateRWLock( const BaseType_t xPreferWriters )
     {
-        QueueHandle_t xHandle = NULL;
-
-        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
-
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
-        {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxRWLockLength = ( UBaseType_t ) 1, uxRWLockSize = ( UBaseType_t ) 0;
 
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+        traceENTER_xQueueCreateRWLock( xPreferWriters );
 
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
-        }
-        else
-        {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
-        }
+        xNewQueue = xQueueGenericCreate( uxRWLockLength, uxRWLockSize, queueQUEUE_TYPE_RWLOCK );
+        prvInitialiseRWLock( ( Queue_t * ) xNewQueue, xPreferWriters );
 
-        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+        traceRETURN_xQueueCreateRWLock( xNewQueue );
 
-        return xHandle;
+        return xNewQueue;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* ( ( configUSE_RWLOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+#if ( ( configUSE_RWLOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    QueueHandle_t xQueueCreateRWLockStatic( const BaseType_t xPreferWriters,
+                                            StaticQueue_t * pxStaticQueue )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxRWLockLength = ( UBaseType_t ) 1, uxRWLockSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateRWLockStatic( xPreferWriters, pxStaticQueue );
+
+        xNewQueue = xQueueGenericCreateStatic( uxRWLockLength, uxRWLockSize, NULL, pxStaticQueue, queueQUEUE_TYPE_RWLOCK );
+        prvInitialiseRWLock( ( Queue_t * ) xNewQueue, xPreferWriters );
+
+        traceRETURN_xQueueCreateRWLockStatic( xNewQueue );
+
+        return xNewQueue;
     }
-    #endif
 
-    /*lint -save -e904 This function relaxes the coding standard somewhat to
-     * allow return statements within the function itself.  This is done in the
-     * interest of execution time efficiency. */
-    for( ; ; )
+#endif /* ( ( configUSE_RWLOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RWLOCKS == 1 )
+
+    BaseType_t xQueueRWLockTake( QueueHandle_t xRWLock,
+                                 TickType_t xTicksToWait,
+                                 const BaseType_t xForWriting )
     {
-        taskENTER_CRITICAL();
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xInheritanceOccurred = pdFALSE;
+        BaseType_t xYieldRequired;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxRWLock = ( Queue_t * ) xRWLock;
+
+        traceENTER_xQueueRWLockTake( xRWLock, xTicksToWait, xForWriting );
+
+        configASSERT( pxRWLock );
+        configASSERT( pxRWLock->uxItemSize == 0 );
+
+        /* The lock is not recursive, so a task that holds the lock for writing
+         * would deadlock if it tried to take the lock again. */
+        configASSERT( pxRWLock->u.xSemaphore.xMutexHolder != xTaskGetCurrentTaskHandle() );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* Is there room on the queue now?  The running task must be the
-             * highest priority task wanting to access the queue.  If the head item
-             * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in
+         * the interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxRWLock );
             {
-                traceQUEUE_SEND( pxQueue );
+                if( prvRWLockIsAvailable( pxRWLock, xForWriting ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE( pxRWLock );
 
-                #if ( configUSE_QUEUE_SETS == 1 )
+                    if( xForWriting != pdFALSE )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxRWLock->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                    }
+                    else
+                    {
+                        pxRWLock->uxMessagesWaiting = ( UBaseType_t ) ( pxRWLock->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                    }
+
+                    queueEXIT_CRITICAL( pxRWLock );
+
+                    traceRETURN_xQueueRWLockTake( pdPASS );
+
+                    return pdPASS;
+                }
+                else
                 {
-                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The lock is not available and no block time is
+                         * specified (or the block time has expired) so exit
+                         * now. */
+                        queueEXIT_CRITICAL( pxRWLock );
 
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+                        traceQUEUE_RECEIVE_FAILED( pxRWLock );
+                        traceRETURN_xQueueRWLockTake( pdFAIL );
 
-                    if( pxQueue->pxQueueSetContainer != NULL )
+                        return pdFAIL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
-                        {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
-                        {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock. A context switch is required. */
-                            queueYIELD_IF_USING_PREEMPTION();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        /* The lock is not available and a block time was
+                         * specified so configure the timeout structure ready to
+                         * block. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
                     }
                     else
                     {
-                        /* If there was a task waiting for data to arrive on the
-                         * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxRWLock );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxRWLock );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                BaseType_t xAvailable;
+
+                queueENTER_CRITICAL( pxRWLock );
+                {
+                    xAvailable = prvRWLockIsAvailable( pxRWLock, xForWriting );
+                }
+                queueEXIT_CRITICAL( pxRWLock );
+
+                if( xAvailable == pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxRWLock );
+
+                    /* Only a task holding the lock for writing inherits the
+                     * priority of the tasks waiting for the lock.  If the lock
+                     * is held by readers there is no holder to inherit. */
+                    if( pxRWLock->u.xSemaphore.xMutexHolder != NULL )
+                    {
+                        taskENTER_CRITICAL();
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( xTaskPriorityInherit( pxRWLock->u.xSemaphore.xMutexHolder ) != pdFALSE )
                             {
-                                /* The unblocked task has a priority higher than
-                                 * our own so yield immediately.  Yes it is ok to
-                                 * do this from within the critical section - the
-                                 * kernel takes care of that. */
-                                queueYIELD_IF_USING_PREEMPTION();
+                                xInheritanceOccurred = pdTRUE;
                             }
                             else
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
                         }
-                        else if( xYieldRequired != pdFALSE )
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xForWriting != pdFALSE )
+                    {
+                        vTaskPlaceOnEventList( &( pxRWLock->xTasksWaitingToSend ), xTicksToWait );
+                    }
+                    else
+                    {
+                        vTaskPlaceOnEventList( &( pxRWLock->xTasksWaitingToReceive ), xTicksToWait );
+                    }
+
+                    prvUnlockQueue( pxRWLock );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* There was no timeout and the lock became available, so
+                     * attempt to take the lock again. */
+                    prvUnlockQueue( pxRWLock );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxRWLock );
+                ( void ) xTaskResumeAll();
+
+                queueENTER_CRITICAL( pxRWLock );
+                {
+                    if( prvRWLockIsAvailable( pxRWLock, xForWriting ) == pdFALSE )
+                    {
+                        xYieldRequired = pdFALSE;
+
+                        if( xInheritanceOccurred != pdFALSE )
                         {
-                            /* This path is a special case that will only get
-                             * executed if the task was holding multiple mutexes
-                             * and the mutexes were given back in an order that is
-                             * different to that in which they were taken. */
-                            queueYIELD_IF_USING_PREEMPTION();
+                            /* This task caused the task holding the lock for
+                             * writing to inherit its priority.  Drop the holder
+                             * back to the priority of the highest priority task
+                             * still waiting for the lock. */
+                            vTaskPriorityDisinheritAfterTimeout( pxRWLock->u.xSemaphore.xMutexHolder, prvGetRWLockDisinheritPriority( pxRWLock ) );
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                }
-                #else /* configUSE_QUEUE_SETS */
-                {
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-                    /* If there was a task waiting for data to arrive on the
-                     * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( xForWriting != pdFALSE )
+                        {
+                            /* When writers are preferred, readers may be
+                             * waiting only because this task was waiting. */
+                            xYieldRequired = prvRWLockUnblockWaiters( pxRWLock );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( xYieldRequired != pdFALSE )
                         {
-                            /* The unblocked task has a priority higher than
-                             * our own so yield immediately.  Yes it is ok to do
-                             * this from within the critical section - the kernel
-                             * takes care of that. */
                             queueYIELD_IF_USING_PREEMPTION();
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                    else if( xYieldRequired != pdFALSE )
-                    {
-                        /* This path is a special case that will only get
-                         * executed if the task was holding multiple mutexes and
-                         * the mutexes were given back in an order that is
-                         * different to that in which they were taken. */
-                        queueYIELD_IF_USING_PREEMPTION();
+
+                        queueEXIT_CRITICAL( pxRWLock );
+
+                        traceQUEUE_RECEIVE_FAILED( pxRWLock );
+                        traceRETURN_xQueueRWLockTake( pdFAIL );
+
+                        return pdFAIL;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                queueEXIT_CRITICAL( pxRWLock );
+            }
+        } /*lint -restore */
+    }
 
-                taskEXIT_CRITICAL();
+#endif /* configUSE_RWLOCKS */
+/*-----------------------------------------------------------*/
 
-                traceRETURN_xQueueGenericSend( pdPASS );
+#if ( configUSE_RWLOCKS == 1 )
 
-                return pdPASS;
-            }
-            else
-            {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was full and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+    BaseType_t xQueueRWLockGive( QueueHandle_t xRWLock,
+                                 const BaseType_t xForWriting )
+    {
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
+        Queue_t * const pxRWLock = ( Queue_t * ) xRWLock;
 
-                    /* Return to the original privilege level before exiting
-                     * the function. */
-                    traceQUEUE_SEND_FAILED( pxQueue );
-                    traceRETURN_xQueueGenericSend( errQUEUE_FULL );
+        traceENTER_xQueueRWLockGive( xRWLock, xForWriting );
 
-                    return errQUEUE_FULL;
-                }
-                else if( xEntryTimeSet == pdFALSE )
+        configASSERT( pxRWLock );
+
+        queueENTER_CRITICAL( pxRWLock );
+        {
+            if( xForWriting != pdFALSE )
+            {
+                /* Only the task that holds the lock for writing can give it. */
+                if( pxRWLock->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
                 {
-                    /* The queue was full and a block time was specified so
-                     * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
+                    traceQUEUE_SEND( pxRWLock );
+
+                    /* The holder may have inherited a priority while it held
+                     * the lock. */
+                    xYieldRequired = xTaskPriorityDisinherit( pxRWLock->u.xSemaphore.xMutexHolder );
+                    pxRWLock->u.xSemaphore.xMutexHolder = NULL;
+                    xReturn = pdPASS;
                 }
                 else
                 {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
+                    traceQUEUE_SEND_FAILED( pxRWLock );
+                    xReturn = pdFAIL;
                 }
             }
-        }
-        taskEXIT_CRITICAL();
-
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now the critical section has been exited. */
+            else
+            {
+                if( pxRWLock->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    traceQUEUE_SEND( pxRWLock );
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+                    pxRWLock->uxMessagesWaiting = ( UBaseType_t ) ( pxRWLock->uxMessagesWaiting - ( UBaseType_t ) 1 );
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    traceQUEUE_SEND_FAILED( pxRWLock );
+                    xReturn = pdFAIL;
+                }
+            }
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
-        {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( xReturn != pdFAIL )
             {
-                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
-
-                /* Unlocking the queue means queue events can effect the
-                 * event list. It is possible that interrupts occurring now
-                 * remove this task from the event list again - but as the
-                 * scheduler is suspended the task will go onto the pending
-                 * ready list instead of the actual ready list. */
-                prvUnlockQueue( pxQueue );
+                if( prvRWLockUnblockWaiters( pxRWLock ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                /* Resuming the scheduler will move tasks from the pending
-                 * ready list into the ready list - so it is feasible that this
-                 * task is already in the ready list before it yields - in which
-                 * case the yield will not cause a context switch unless there
-                 * is also a higher priority task in the pending ready list. */
-                if( xTaskResumeAll() == pdFALSE )
+                if( xYieldRequired != pdFALSE )
                 {
-                    taskYIELD_WITHIN_API();
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
             else
             {
-                /* Try again. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            /* The timeout has expired. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+        queueEXIT_CRITICAL( pxRWLock );
 
-            traceQUEUE_SEND_FAILED( pxQueue );
-            traceRETURN_xQueueGenericSend( errQUEUE_FULL );
+        traceRETURN_xQueueRWLockGive( xReturn );
 
-            return errQUEUE_FULL;
-        }
-    } /*lint -restore */
-}
+        return xReturn;
+    }
+
+#endif /* configUSE_RWLOCKS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
-                                     const void * const pvItemToQueue,
-                                     BaseType_t * const pxHigherPriorityTaskWoken,
-                                     const BaseType_t xCopyPosition )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_RWLOCKS == 1 )
 
-    traceENTER_xQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition );
+    BaseType_t xQueueRWLockTakeReadFromISR( QueueHandle_t xRWLock )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxRWLock = ( Queue_t * ) xRWLock;
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            BaseType_t xKernelLocked;
+        #endif
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        traceENTER_xQueueRWLockTakeReadFromISR( xRWLock );
 
-    /* Similar to xQueueGenericSend, except without blocking if there is no room
-     * in the queue.  Also don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
-    {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        configASSERT( pxRWLock );
+
+        /* See the comments in xQueueGiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxRWLock, &xKernelLocked );
         {
-            const int8_t cTxLock = pxQueue->cTxLock;
-            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+            /* An interrupt cannot block, so only take the lock if it is
+             * available now.  Taking the lock for reading never unblocks a
+             * task. */
+            if( prvRWLockIsAvailable( pxRWLock, pdFALSE ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxRWLock );
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+                pxRWLock->uxMessagesWaiting = ( UBaseType_t ) ( pxRWLock->uxMessagesWaiting + ( UBaseType_t ) 1 );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxRWLock );
+                xReturn = pdFAIL;
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( pxRWLock, xKernelLocked, uxSavedInterruptStatus );
 
-            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
-             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
-             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
-             *  called here even though the disinherit function does not check if
-             *  the scheduler is suspended before accessing the ready lists. */
-            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+        traceRETURN_xQueueRWLockTakeReadFromISR( xReturn );
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+        return xReturn;
+    }
+
+#endif /* configUSE_RWLOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RWLOCKS == 1 )
+
+    BaseType_t xQueueRWLockGiveReadFromISR( QueueHandle_t xRWLock,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxRWLock = ( Queue_t * ) xRWLock;
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            BaseType_t xKernelLocked;
+        #endif
+
+        traceENTER_xQueueRWLockGiveReadFromISR( xRWLock, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxRWLock );
+
+        /* See the comments in xQueueGiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxRWLock, &xKernelLocked );
+        {
+            if( pxRWLock->uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                #if ( configUSE_QUEUE_SETS == 1 )
+                traceQUEUE_SEND_FROM_ISR( pxRWLock );
+
+                pxRWLock->uxMessagesWaiting = ( UBaseType_t ) ( pxRWLock->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                /* The event lists are not altered by an interrupt if the
+                 * queue is locked.  This will be done when the queue is
+                 * unlocked later. */
+                if( queueIS_UNLOCKED( pxRWLock ) != pdFALSE )
                 {
-                    if( pxQueue->pxQueueSetContainer != NULL )
+                    if( prvRWLockUnblockWaiters( pxRWLock ) != pdFALSE )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
-                        {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        if( pxHigherPriorityTaskWoken != NULL )
                         {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            *pxHigherPriorityTaskWoken = pdTRUE;
                         }
                         else
                         {
@@ -1242,171 +1880,222 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #else /* configUSE_QUEUE_SETS */
+                else if( pxRWLock->uxMessagesWaiting == ( UBaseType_t ) 0 )
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Not used in this path. */
-                    ( void ) uxPreviousMessagesWaiting;
+                    /* Releasing the last read lock can only allow a writer to
+                     * take the lock.  A task that locked the queue may have
+                     * found the lock unavailable and be about to wait to
+                     * write, so record the release even if no writer is
+                     * waiting yet.  prvUnlockQueue() then unblocks a writer. */
+                    const int8_t cRxLock = pxRWLock->cRxLock;
+
+                    prvIncrementQueueRxLock( pxRWLock, cRxLock );
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxRWLock );
+                xReturn = pdFAIL;
             }
-
-            xReturn = pdPASS;
-        }
-        else
-        {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
         }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        queueEXIT_CRITICAL_FROM_ISR( pxRWLock, xKernelLocked, uxSavedInterruptStatus );
 
-    traceRETURN_xQueueGenericSendFromISR( xReturn );
+        traceRETURN_xQueueRWLockGiveReadFromISR( xReturn );
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        return xReturn;
+    }
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+#endif /* configUSE_RWLOCKS */
+/*-----------------------------------------------------------*/
 
-    traceENTER_xQueueGiveFromISR( xQueue, pxHigherPriorityTaskWoken );
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
-     * item size is 0.  Don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xHandle = NULL;
 
-    configASSERT( pxQueue );
+        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
 
-    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
-     * if the item size is not 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
 
-    /* Normally a mutex would not be given from an interrupt, especially if
-     * there is a mutex holder, as priority inheritance makes no sense for an
-     * interrupts, only tasks. */
-    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        QueueHandle_t xHandle = NULL;
 
-        /* When the queue is used to implement a semaphore no data is ever
-         * moved through the queue but it is still valid to see if the queue 'has
-         * space'. */
-        if( uxMessagesWaiting < pxQueue->uxLength )
+        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
+
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
         {
-            const int8_t cTxLock = pxQueue->cTxLock;
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
-            /* A task can only have an inherited priority if it is a mutex
-             * holder - and if there is a mutex holder then the mutex cannot be
-             * given from an ISR.  As this is the ISR version of the function it
-             * can be assumed there is no mutex holder and no need to determine if
-             * priority disinheritance is needed.  Simply increase the count of
-             * messages (semaphores) available. */
-            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        /* Giving a mutex never blocks. */
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            const BaseType_t xReturn = prvGiveMutex( pxQueue );
+
+            traceRETURN_xQueueGenericSend( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_MUTEX_FAST_PATH */
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            BaseType_t xReturn;
+
+            /* Items can only be sent to the back of an SPSC queue. */
+            configASSERT( xCopyPosition == queueSEND_TO_BACK );
+
+            xReturn = prvSendSPSC( pxQueue, pvItemToQueue, xTicksToWait );
+
+            traceRETURN_xQueueGenericSend( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvSendWithoutKernelLock( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+        {
+            traceRETURN_xQueueGenericSend( pdPASS );
+
+            return pdPASS;
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Is there room on the queue now?  The running task must be the
+             * highest priority task wanting to access the queue.  If the head item
+             * in the queue is to be overwritten then it does not matter if the
+             * queue is full. */
+            if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+                ( queueSEND_IS_RESERVED( pxQueue, xCopyPosition ) == pdFALSE ) )
             {
+                traceQUEUE_SEND( pxQueue );
+
                 #if ( configUSE_QUEUE_SETS == 1 )
                 {
+                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
                     if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
                         {
-                            /* The semaphore is a member of a queue set, and
-                             * posting to the queue set caused a higher priority
-                             * task to unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock. A context switch is required. */
+                            queueYIELD_IF_USING_PREEMPTION();
                         }
                         else
                         {
@@ -1415,26 +2104,31 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
+                        /* If there was a task waiting for data to arrive on the
+                         * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
                             if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
+                                /* The unblocked task has a priority higher than
+                                 * our own so yield immediately.  Yes it is ok to
+                                 * do this from within the critical section - the
+                                 * kernel takes care of that. */
+                                queueYIELD_IF_USING_PREEMPTION();
                             }
                             else
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
                         }
+                        else if( xYieldRequired != pdFALSE )
+                        {
+                            /* This path is a special case that will only get
+                             * executed if the task was holding multiple mutexes
+                             * and the mutexes were given back in an order that is
+                             * different to that in which they were taken. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
@@ -1443,139 +2137,64 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+                    /* If there was a task waiting for data to arrive on the
+                     * queue then unblock it now. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            /* The unblocked task has a priority higher than
+                             * our own so yield immediately.  Yes it is ok to do
+                             * this from within the critical section - the kernel
+                             * takes care of that. */
+                            queueYIELD_IF_USING_PREEMPTION();
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
+                    else if( xYieldRequired != pdFALSE )
+                    {
+                        /* This path is a special case that will only get
+                         * executed if the task was holding multiple mutexes and
+                         * the mutexes were given back in an order that is
+                         * different to that in which they were taken. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
                 #endif /* configUSE_QUEUE_SETS */
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueueGenericSend( pdPASS );
+
+                return pdPASS;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
-            }
-
-            xReturn = pdPASS;
-        }
-        else
-        {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
-        }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
 
-    traceRETURN_xQueueGiveFromISR( xReturn );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-BaseType_t xQueueReceive( QueueHandle_t xQueue,
-                          void * const pvBuffer,
-                          TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
-
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
-
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer). */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
-
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-    {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
-    #endif
-
-    /*lint -save -e904  This function relaxes the coding standard somewhat to
-     * allow return statements within the function itself.  This is done in the
-     * interest of execution time efficiency. */
-    for( ; ; )
-    {
-        taskENTER_CRITICAL();
-        {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
-            {
-                /* Data available, remove one item. */
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_RECEIVE( pxQueue );
-                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
-
-                /* There is now space in the queue, were any tasks waiting to
-                 * post to the queue?  If so, unblock the highest priority waiting
-                 * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                taskEXIT_CRITICAL();
-
-                traceRETURN_xQueueReceive( pdPASS );
-
-                return pdPASS;
-            }
-            else
-            {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was empty and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
-
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+                    /* Return to the original privilege level before exiting
+                     * the function. */
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
-                    return errQUEUE_EMPTY;
+                    return errQUEUE_FULL;
                 }
                 else if( xEntryTimeSet == pdFALSE )
                 {
-                    /* The queue was empty and a block time was specified so
+                    /* The queue was full and a block time was specified so
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
@@ -1587,7 +2206,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
         /* Interrupts and other tasks can send to and receive from the queue
          * now the critical section has been exited. */
@@ -1598,124 +2217,2126 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* The timeout has not expired.  If the queue is still empty place
-             * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, xCopyPosition ) != pdFALSE )
             {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+
+                /* Unlocking the queue means queue events can effect the
+                 * event list. It is possible that interrupts occurring now
+                 * remove this task from the event list again - but as the
+                 * scheduler is suspended the task will go onto the pending
+                 * ready list instead of the actual ready list. */
                 prvUnlockQueue( pxQueue );
 
+                /* Resuming the scheduler will move tasks from the pending
+                 * ready list into the ready list - so it is feasible that this
+                 * task is already in the ready list before it yields - in which
+                 * case the yield will not cause a context switch unless there
+                 * is also a higher priority task in the pending ready list. */
                 if( xTaskResumeAll() == pdFALSE )
                 {
                     taskYIELD_WITHIN_API();
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
             }
             else
             {
-                /* The queue contains data again.  Loop back to try and read the
-                 * data. */
+                /* Try again. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
             }
         }
         else
         {
-            /* Timed out.  If there is no data in the queue exit, otherwise loop
-             * back and attempt to read the data. */
+            /* The timeout has expired. */
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+            traceQUEUE_SEND_FAILED( pxQueue );
+            traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
-                return errQUEUE_EMPTY;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            return errQUEUE_FULL;
         }
     } /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemToQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken,
+                                     const BaseType_t xCopyPosition )
 {
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
 
-    #if ( configUSE_MUTEXES == 1 )
-        BaseType_t xInheritanceOccurred = pdFALSE;
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        BaseType_t xKernelLocked;
     #endif
 
-    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
+    traceENTER_xQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition );
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
 
-    /* Check this really is a semaphore, in which case the item size will be
-     * 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    #if ( configUSE_QUEUE_SPSC == 1 )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            configASSERT( xCopyPosition == queueSEND_TO_BACK );
+
+            xReturn = prvSendSPSCFromISR( pxQueue, pvItemToQueue, pxHigherPriorityTaskWoken );
+
+            traceRETURN_xQueueGenericSendFromISR( xReturn );
+
+            return xReturn;
+        }
     }
-    #endif
+    #endif /* configUSE_QUEUE_SPSC */
 
-    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
-     * statements within the function itself.  This is done in the interest
-     * of execution time efficiency. */
-    for( ; ; )
+    /* Similar to xQueueGenericSend, except without blocking if there is no room
+     * in the queue.  Also don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue, &xKernelLocked );
     {
-        taskENTER_CRITICAL();
+        if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+            ( queueSEND_IS_RESERVED( pxQueue, xCopyPosition ) == pdFALSE ) )
         {
-            /* Semaphores are queues with an item size of 0, and where the
-             * number of messages in the queue is the semaphore's count value. */
-            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
-            {
-                traceQUEUE_RECEIVE( pxQueue );
+            const int8_t cTxLock = pxQueue->cTxLock;
+            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-                /* Semaphores are queues with a data size of zero and where the
-                 * messages waiting is the semaphore's count.  Reduce the count. */
-                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-                    {
-                        /* Record the information required to implement
-                         * priority inheritance should it become necessary. */
-                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                #endif /* configUSE_MUTEXES */
+            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
+             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
+             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
+             *  called here even though the disinherit function does not check if
+             *  the scheduler is suspended before accessing the ready lists. */
+            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-                /* Check to see if other tasks are blocked waiting to give the
-                 * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        queueYIELD_IF_USING_PREEMPTION();
+                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        {
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Not used in this path. */
+                    ( void ) uxPreviousMessagesWaiting;
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, uxSavedInterruptStatus );
+
+    traceRETURN_xQueueGenericSendFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        BaseType_t xKernelLocked;
+    #endif
+
+    traceENTER_xQueueGiveFromISR( xQueue, pxHigherPriorityTaskWoken );
+
+    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
+     * item size is 0.  Don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+
+    configASSERT( pxQueue );
+
+    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
+     * if the item size is not 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Normally a mutex would not be given from an interrupt, especially if
+     * there is a mutex holder, as priority inheritance makes no sense for an
+     * interrupts, only tasks. */
+    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue, &xKernelLocked );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* When the queue is used to implement a semaphore no data is ever
+         * moved through the queue but it is still valid to see if the queue 'has
+         * space'. */
+        if( uxMessagesWaiting < pxQueue->uxLength )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            /* A task can only have an inherited priority if it is a mutex
+             * holder - and if there is a mutex holder then the mutex cannot be
+             * given from an ISR.  As this is the ISR version of the function it
+             * can be assumed there is no mutex holder and no need to determine if
+             * priority disinheritance is needed.  Simply increase the count of
+             * messages (semaphores) available. */
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The semaphore is a member of a queue set, and
+                             * posting to the queue set caused a higher priority
+                             * task to unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, uxSavedInterruptStatus );
+
+    traceRETURN_xQueueGiveFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer). */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            const BaseType_t xReturn = prvReceiveSPSC( pxQueue, pvBuffer, xTicksToWait, pdFALSE );
+
+            traceRETURN_xQueueReceive( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvReceiveWithoutKernelLock( pxQueue, pvBuffer, pdFALSE ) != pdFALSE )
+        {
+            traceRETURN_xQueueReceive( pdPASS );
+
+            return pdPASS;
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+            {
+                /* Data available, remove one item. */
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                /* There is now space in the queue, were any tasks waiting to
+                 * post to the queue?  If so, unblock the highest priority waiting
+                 * task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueueReceive( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xInheritanceOccurred = pdFALSE;
+    #endif
+
+    #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        BaseType_t xSpinAttempted = pdFALSE;
+        BaseType_t xMutexReleasedWhileSpinning = pdFALSE;
+    #endif
+
+    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Check this really is a semaphore, in which case the item size will be
+     * 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+     * statements within the function itself.  This is done in the interest
+     * of execution time efficiency. */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvReceiveWithoutKernelLock( pxQueue, NULL, pdFALSE ) != pdFALSE )
+        {
+            traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+            return pdPASS;
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        /* Take an uncontended mutex without entering a critical section.  A
+         * priority ceiling mutex must raise the priority of its holder, so is
+         * always taken below. */
+        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+            ( queueHAS_PRIORITY_CEILING( pxQueue ) == pdFALSE ) &&
+            ( pxQueue->ulMutexContended == 0U ) &&
+            ( prvClaimMutex( pxQueue ) != pdFALSE ) )
+        {
+            traceQUEUE_RECEIVE( pxQueue );
+
+            /* The count is a copy of the mutex state that is only written by
+             * the holder. */
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+            ( void ) pvTaskIncrementMutexHeldCount();
+
+            traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+            return pdPASS;
+        }
+    }
+    #endif /* configUSE_MUTEX_FAST_PATH */
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Semaphores are queues with an item size of 0, and where the
+             * number of messages in the queue is the semaphore's count value. */
+            UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* A mutex is available if the calling task can claim it. */
+                if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    uxSemaphoreCount = ( prvClaimMutex( pxQueue ) != pdFALSE ) ? ( UBaseType_t ) 1 : ( UBaseType_t ) 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_MUTEX_FAST_PATH */
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* Semaphores are queues with a data size of zero and where the
+                 * messages waiting is the semaphore's count.  Reduce the count. */
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+                        {
+                            /* A priority ceiling mutex raises its holder to the
+                             * ceiling as soon as it is taken, so no task that
+                             * uses the mutex can preempt the holder. */
+                            if( queueHAS_PRIORITY_CEILING( pxQueue ) != pdFALSE )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_MUTEX_PRIORITY_CEILING */
+
+                        #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+                        {
+                            if( xMutexReleasedWhileSpinning != pdFALSE )
+                            {
+                                pxQueue->ulSpinAcquisitions++;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_ADAPTIVE_MUTEXES */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                /* Check to see if other tasks are blocked waiting to give the
+                 * semaphore, and if so, unblock the highest priority such task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The semaphore count was 0 and no block time is specified
+                     * (or the block time has expired) so exit now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The semaphore count was 0 and a block time was specified
+                     * so configure the timeout structure ready to block. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can give to and take from the semaphore
+         * now the critical section has been exited. */
+
+        #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+        {
+            /* Blocking costs two context switches, which is more than the time
+             * a holder running on another core is likely to keep the mutex, so
+             * spin first.  Only spin once per call, whether or not the spin saw
+             * the mutex released, so a task that keeps failing to obtain the
+             * mutex still ends up blocking. */
+            if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xSpinAttempted == pdFALSE ) )
+            {
+                xSpinAttempted = pdTRUE;
+
+                if( prvSpinWhileMutexHolderRuns( pxQueue ) != pdFALSE )
+                {
+                    xMutexReleasedWhileSpinning = pdTRUE;
+                    continue;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_ADAPTIVE_MUTEXES */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* Make the holder give the mutex on the slow path, which
+                 * unblocks this task.  The flag is set before the holder is
+                 * read, and the holder releases the mutex before reading the
+                 * flag, so either this task sees the mutex is available or the
+                 * holder sees the flag. */
+                if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    ( void ) Atomic_OR_u32( &( pxQueue->ulMutexContended ), 1U );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_MUTEX_FAST_PATH */
+
+            /* A block time is specified and not expired.  If the semaphore
+             * count is 0 then enter the Blocked state to wait for a semaphore to
+             * become available.  As semaphores are implemented with queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* The holder of a priority ceiling mutex is already
+                     * running at the ceiling, so does not inherit. */
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+                        ( queueHAS_PRIORITY_CEILING( pxQueue ) == pdFALSE ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                            {
+                                /* Record the mutex so a task blocking on a mutex
+                                 * held by this task can find this mutex's
+                                 * holder. */
+                                vTaskSetBlockingMutex( ( void * ) pxQueue );
+                                xInheritanceOccurred = prvInheritThroughMutexChain( pxQueue );
+                            }
+                            #else
+                            {
+                                xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            #endif
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+                #if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        queueENTER_CRITICAL( pxQueue );
+                        {
+                            pxQueue->ulBlockingWaits++;
+                        }
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        /* The spin did not obtain the mutex, so obtaining it
+                         * after this block is not a spin acquisition. */
+                        xMutexReleasedWhileSpinning = pdFALSE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_ADAPTIVE_MUTEXES */
+
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                {
+                    /* This task is no longer blocked on the mutex. */
+                    vTaskSetBlockingMutex( NULL );
+                }
+                #endif
+            }
+            else
+            {
+                /* There was no timeout and the semaphore count was not 0, so
+                 * attempt to take the semaphore again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            /* If the semaphore count is 0 exit now as the timeout has
+             * expired.  Otherwise return to attempt to take the semaphore that is
+             * known to be available.  As semaphores are implemented by queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* xInheritanceOccurred could only have be set if
+                     * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
+                     * test the mutex type again to check it is actually a mutex. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                            {
+                                /* The priority may also have been inherited by
+                                 * the holders further along the chain. */
+                                prvDisinheritThroughMutexChainAfterTimeout( pxQueue );
+                            }
+                            #else
+                            {
+                                UBaseType_t uxHighestWaitingPriority;
+
+                                /* This task blocking on the mutex caused another
+                                 * task to inherit this task's priority.  Now this task
+                                 * has timed out the priority should be disinherited
+                                 * again, but only as low as the next highest priority
+                                 * task that is waiting for the same mutex. */
+                                uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+                                vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                            }
+                            #endif
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer. */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            const BaseType_t xReturn = prvReceiveSPSC( pxQueue, pvBuffer, xTicksToWait, pdTRUE );
+
+            traceRETURN_xQueuePeek( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvReceiveWithoutKernelLock( pxQueue, pvBuffer, pdTRUE ) != pdFALSE )
+        {
+            traceRETURN_xQueuePeek( pdPASS );
+
+            return pdPASS;
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+            {
+                /* Remember the read position so it can be reset after the data
+                 * is read from the queue as this function is only peeking the
+                 * data, not removing it. */
+                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_PEEK( pxQueue );
+
+                /* The data is not being removed, so reset the read pointer. */
+                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+                /* The data is being left in the queue, so see if there are
+                 * any other tasks waiting for the data. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than this task. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueuePeek( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure ready to enter the blocked
+                     * state. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now that the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* Timeout has not expired yet, check to see if there is data in the
+            * queue now, and if not enter the Blocked state to wait for data. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* There is data in the queue now, so don't enter the blocked
+                 * state, instead return to try and obtain the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired.  If there is still no data in the queue
+             * exit, otherwise go back and try to read the data again. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_PEEK_FAILED( pxQueue );
+                traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        BaseType_t xKernelLocked;
+    #endif
+
+    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            xReturn = prvReceiveSPSCFromISR( pxQueue, pvBuffer, pxHigherPriorityTaskWoken, pdFALSE );
+
+            traceRETURN_xQueueReceiveFromISR( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue, &xKernelLocked );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than us so
+                         * force a context switch. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was removed while it was locked. */
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, uxSavedInterruptStatus );
+
+    traceRETURN_xQueueReceiveFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    #if ( configUSE_QUEUE_SPSC == 1 )
+    {
+        if( pxQueue->ucIsSPSC != pdFALSE )
+        {
+            xReturn = prvReceiveSPSCFromISR( pxQueue, pvBuffer, NULL, pdTRUE );
+
+            traceRETURN_xQueuePeekFromISR( xReturn );
+
+            return xReturn;
+        }
+    }
+    #endif /* configUSE_QUEUE_SPSC */
+
+    uxSavedInterruptStatus = queueENTER_OBJECT_CRITICAL_FROM_ISR( pxQueue );
+    {
+        /* Cannot block in an ISR, so check there is data available. */
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+        {
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+            /* Remember the read position so it can be reset as nothing is
+             * actually being removed from the queue. */
+            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    queueEXIT_OBJECT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
+
+    traceRETURN_xQueuePeekFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueReserveSend( QueueHandle_t xQueue,
+                                  void ** const ppvSlot,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReserveSend( xQueue, ppvSlot, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( ppvSlot );
+
+        /* Semaphores and mutexes have no storage area to reserve a slot in. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* Is there room on the queue now, and is no other slot
+                 * reserved? */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( queueSEND_IS_RESERVED( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+                {
+                    /* The slot at the write position is not counted as an item
+                     * until it is committed, so receivers cannot see it, and
+                     * other senders are held off until then. */
+                    pxQueue->ucReservations |= queueRESERVED_FOR_SEND;
+                    *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueueReserveSend( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was full and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueReserveSend( errQUEUE_FULL );
+
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was full and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueReserveSend( errQUEUE_FULL );
+
+                return errQUEUE_FULL;
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommitSend( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueCommitSend( xQueue );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( ( pxQueue->ucReservations & queueRESERVED_FOR_SEND ) != 0U )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                /* The item was written in place, so only the write position
+                 * and the number of items need to be updated. */
+                pxQueue->ucReservations &= ( uint8_t ) ~queueRESERVED_FOR_SEND;
+                pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+                {
+                    pxQueue->pcWriteTo = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+
+                /* Notify the queue set, or unblock a task waiting for data to
+                 * arrive on the queue, as xQueueGenericSend() does. */
+                if( queueIS_SET_MEMBER( pxQueue ) != pdFALSE )
+                {
+                    #if ( configUSE_QUEUE_SETS == 1 )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_QUEUE_SETS */
+                }
+                else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Tasks may have blocked sending to the queue only because the
+                 * slot was reserved, so unblock one if there is still space. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                /* No slot is reserved. */
+                xReturn = pdFAIL;
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_xQueueCommitSend( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueuePeekReserve( QueueHandle_t xQueue,
+                                  void ** const ppvItem,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        int8_t * pcItem;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueuePeekReserve( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( ppvItem );
+
+        /* Semaphores and mutexes have no storage area to reserve an item in. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* Is there data in the queue now that is not already
+                 * reserved? */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                    ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+                {
+                    /* The item stays in the queue, and is counted as an item,
+                     * until it is released, so senders cannot overwrite it.
+                     * Other receivers are held off until then. */
+                    pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                    {
+                        pcItem = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_PEEK( pxQueue );
+                    pxQueue->ucReservations |= queueRESERVED_FOR_RECEIVE;
+                    *ppvItem = ( void * ) pcItem;
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueuePeekReserve( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_PEEK_FAILED( pxQueue );
+                        traceRETURN_xQueuePeekReserve( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * reserve it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to reserve the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    traceRETURN_xQueuePeekReserve( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReleaseReceive( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReleaseReceive( xQueue );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( ( pxQueue->ucReservations & queueRESERVED_FOR_RECEIVE ) != 0U )
+            {
+                /* The item was read in place, so only the read position and
+                 * the number of items need to be updated. */
+                pxQueue->ucReservations &= ( uint8_t ) ~queueRESERVED_FOR_RECEIVE;
+                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                {
+                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+                /* There is now space in the queue, were any tasks waiting to
+                 * post to the queue?  If so, unblock the highest priority
+                 * waiting task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Tasks may have blocked receiving from the queue only because
+                 * the item was reserved, so unblock one if there is still data
+                 * in the queue. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                    ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                /* No item is reserved. */
+                xReturn = pdFAIL;
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_xQueueReleaseReceive( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_TRANSFERS == 1 )
+
+    UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                     const void * const pvItemsToQueue,
+                                     const UBaseType_t uxItemCount,
+                                     TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( pvItemsToQueue );
+
+        /* Semaphores and mutexes have no item storage to copy into. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* As many items as fit are copied in, so the call only blocks
+                 * while the queue has no space at all. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                    ( queueSEND_IS_RESERVED( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    uxReturn = prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemCount );
+
+                    /* Unblock one receiving task per item posted, then yield
+                     * at most once for the whole batch. */
+                    if( prvNotifyItemsSent( pxQueue, uxReturn ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_uxQueueSendMultiple( uxReturn );
+
+                    return uxReturn;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was full and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_uxQueueSendMultiple( 0 );
+
+                        return 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was full and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_uxQueueSendMultiple( 0 );
+
+                return 0;
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        const UBaseType_t uxMaxItems,
+                                        TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                /* Take whatever is available up to uxMaxItems, so the call only
+                 * blocks while the queue is empty. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+                {
+                    uxReturn = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    /* There is now space for uxReturn items, so unblock up to
+                     * that many sending tasks and yield at most once. */
+                    if( prvUnblockTasksForItems( &( pxQueue->xTasksWaitingToSend ), uxReturn ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_uxQueueReceiveMultiple( uxReturn );
+
+                    return uxReturn;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_uxQueueReceiveMultiple( 0 );
+
+                        return 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and read
+                     * the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to read the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_uxQueueReceiveMultiple( 0 );
+
+                    return 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItemsToQueue,
+                                            const UBaseType_t uxItemCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            BaseType_t xKernelLocked;
+        #endif
+
+        traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( pvItemsToQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue, &xKernelLocked );
+        {
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                ( queueSEND_IS_RESERVED( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+            {
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                uxReturn = prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemCount );
+
+                /* The event list is not altered if the queue is locked.  This
+                 * will be done when the queue is unlocked later. */
+                if( pxQueue->cTxLock == queueUNLOCKED )
+                {
+                    if( prvNotifyItemsSent( pxQueue, uxReturn ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
@@ -1724,204 +4345,512 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                taskEXIT_CRITICAL();
+                    UBaseType_t uxItem;
 
-                traceRETURN_xQueueSemaphoreTake( pdPASS );
+                    /* Increment the lock count once per item so the task that
+                     * unlocks the queue wakes one receiver for each. */
+                    for( uxItem = 0U; uxItem < uxReturn; uxItem++ )
+                    {
+                        const int8_t cTxLock = pxQueue->cTxLock;
 
-                return pdPASS;
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    }
+                }
             }
             else
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The semaphore count was 0 and no block time is specified
-                     * (or the block time has expired) so exit now. */
-                    taskEXIT_CRITICAL();
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                uxReturn = 0;
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, uxSavedInterruptStatus );
 
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+        traceRETURN_uxQueueSendMultipleFromISR( uxReturn );
 
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               const UBaseType_t uxMaxItems,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            BaseType_t xKernelLocked;
+        #endif
+
+        traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( queueIS_SPSC( pxQueue ) == pdFALSE );
+        configASSERT( pvBuffer );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue, &xKernelLocked );
+        {
+            if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                uxReturn = prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxMaxItems );
+
+                /* If the queue is locked the event list will not be modified.
+                 * Instead update the lock count once per item removed. */
+                if( pxQueue->cRxLock == queueUNLOCKED )
                 {
-                    /* The semaphore count was 0 and a block time was specified
-                     * so configure the timeout structure ready to block. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
+                    if( prvUnblockTasksForItems( &( pxQueue->xTasksWaitingToSend ), uxReturn ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
+                    UBaseType_t uxItem;
+
+                    for( uxItem = 0U; uxItem < uxReturn; uxItem++ )
+                    {
+                        const int8_t cRxLock = pxQueue->cRxLock;
+
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    }
                 }
             }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+                uxReturn = 0;
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( pxQueue, xKernelLocked, uxSavedInterruptStatus );
+
+        traceRETURN_uxQueueReceiveMultipleFromISR( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFERS */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    traceENTER_uxQueueMessagesWaiting( xQueue );
+
+    configASSERT( xQueue );
+
+    queueENTER_OBJECT_CRITICAL( ( Queue_t * ) xQueue );
+    {
+        uxReturn = queueMESSAGES_WAITING( ( Queue_t * ) xQueue );
+    }
+    queueEXIT_OBJECT_CRITICAL( ( Queue_t * ) xQueue );
+
+    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueSpacesAvailable( xQueue );
+
+    configASSERT( pxQueue );
+
+    queueENTER_OBJECT_CRITICAL( pxQueue );
+    {
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - queueMESSAGES_WAITING( pxQueue ) );
+    }
+    queueEXIT_OBJECT_CRITICAL( pxQueue );
+
+    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+
+    configASSERT( pxQueue );
+    uxReturn = queueMESSAGES_WAITING( pxQueue );
+
+    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_vQueueDelete( xQueue );
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+    traceRETURN_vQueueDelete();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        traceENTER_uxQueueGetQueueNumber( xQueue );
+
+        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+
+        traceRETURN_vQueueSetQueueNumber();
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        traceENTER_ucQueueGetQueueType( xQueue );
+
+        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueItemSize( xQueue );
+
+    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+
+    return ( ( Queue_t * ) xQueue )->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueLength( xQueue );
+
+    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+
+    return ( ( Queue_t * ) xQueue )->uxLength;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    static BaseType_t prvInheritThroughMutexChain( const Queue_t * pxMutex )
+    {
+        const TaskHandle_t xCallingTask = xTaskGetCurrentTaskHandle();
+        TaskHandle_t xHolder = pxMutex->u.xSemaphore.xMutexHolder;
+        BaseType_t xInheritanceOccurred, xHolderInherited;
+        UBaseType_t uxDepth;
+
+        xInheritanceOccurred = xTaskPriorityInherit( xHolder );
+        xHolderInherited = xInheritanceOccurred;
+
+        /* Holders that did not need to inherit were either already raised by
+         * this walk or an earlier one, or have a priority above the calling
+         * task's, so the rest of the chain is already high enough. */
+        for( uxDepth = ( UBaseType_t ) 1; ( xHolderInherited != pdFALSE ) && ( uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ); uxDepth++ )
+        {
+            pxMutex = ( const Queue_t * ) pvTaskGetBlockingMutex( xHolder );
+
+            /* The chain ends at a holder that is not blocked on a mutex, or is
+             * blocked on a priority ceiling mutex, the holder of which already
+             * runs at the ceiling.  A chain that leads back to the calling task
+             * is a deadlock, which inheritance cannot resolve. */
+            if( ( pxMutex != NULL ) &&
+                ( queueHAS_PRIORITY_CEILING( pxMutex ) == pdFALSE ) &&
+                ( pxMutex->u.xSemaphore.xMutexHolder != xCallingTask ) )
+            {
+                xHolder = pxMutex->u.xSemaphore.xMutexHolder;
+                xHolderInherited = xTaskPriorityInherit( xHolder );
+            }
+            else
+            {
+                xHolderInherited = pdFALSE;
+            }
         }
-        taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can give to and take from the semaphore
-         * now the critical section has been exited. */
+        return xInheritanceOccurred;
+    }
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
-        {
-            /* A block time is specified and not expired.  If the semaphore
-             * count is 0 then enter the Blocked state to wait for a semaphore to
-             * become available.  As semaphores are implemented with queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
 
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
+    static void prvDisinheritThroughMutexChainAfterTimeout( const Queue_t * pxMutex )
+    {
+        const TaskHandle_t xCallingTask = xTaskGetCurrentTaskHandle();
+        TaskHandle_t xHolder;
+        UBaseType_t uxDepth;
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+        for( uxDepth = ( UBaseType_t ) 0; ( pxMutex != NULL ) && ( uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH ); uxDepth++ )
+        {
+            xHolder = pxMutex->u.xSemaphore.xMutexHolder;
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            if( ( xHolder != NULL ) &&
+                ( xHolder != xCallingTask ) &&
+                ( queueHAS_PRIORITY_CEILING( pxMutex ) == pdFALSE ) )
+            {
+                /* The holder keeps the priority of the highest priority task
+                 * still waiting for the mutex, which includes the holder further
+                 * back along the chain now that its priority has been dropped. */
+                vTaskPriorityDisinheritAfterTimeout( xHolder, prvGetDisinheritPriorityAfterTimeout( pxMutex ) );
+                pxMutex = ( const Queue_t * ) pvTaskGetBlockingMutex( xHolder );
             }
             else
             {
-                /* There was no timeout and the semaphore count was not 0, so
-                 * attempt to take the semaphore again. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                pxMutex = NULL;
             }
         }
-        else
-        {
-            /* Timed out. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+    }
 
-            /* If the semaphore count is 0 exit now as the timeout has
-             * expired.  Otherwise return to attempt to take the semaphore that is
-             * known to be available.  As semaphores are implemented by queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* xInheritanceOccurred could only have be set if
-                     * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
-                     * test the mutex type again to check it is actually a mutex. */
-                    if( xInheritanceOccurred != pdFALSE )
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            UBaseType_t uxHighestWaitingPriority;
-
-                            /* This task blocking on the mutex caused another
-                             * task to inherit this task's priority.  Now this task
-                             * has timed out the priority should be disinherited
-                             * again, but only as low as the next highest priority
-                             * task that is waiting for the same mutex. */
-                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
-                }
-                #endif /* configUSE_MUTEXES */
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
 
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
 
-                return errQUEUE_EMPTY;
+    static BaseType_t prvSpinWhileMutexHolderRuns( const Queue_t * pxMutex )
+    {
+        BaseType_t xReleased = pdFALSE;
+        TaskHandle_t xHolder;
+        uint32_t ulSpins;
+
+        for( ulSpins = 0U; ulSpins < ( uint32_t ) configADAPTIVE_MUTEX_SPIN_COUNT; ulSpins++ )
+        {
+            /* The mutex is read without entering a critical section, so read
+             * the holder through a volatile pointer to ensure it is re-read on
+             * each iteration.  The holder is cleared when the mutex is given. */
+            xHolder = *( ( TaskHandle_t const volatile * ) &( pxMutex->u.xSemaphore.xMutexHolder ) );
+
+            if( xHolder == NULL )
+            {
+                xReleased = pdTRUE;
+                break;
             }
-            else
+
+            /* There is no point spinning while the holder is not running, as it
+             * cannot release the mutex. */
+            if( xTaskIsRunningOnAnotherCore( xHolder ) == pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                break;
             }
-        }
-    } /*lint -restore */
-}
-/*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
-    Queue_t * const pxQueue = xQueue;
+            portSPIN_WAIT_HINT();
+        }
 
-    traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
+        return xReleased;
+    }
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer. */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    static BaseType_t prvClaimMutex( Queue_t * const pxMutex )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        BaseType_t xReturn;
+
+        if( Atomic_CompareAndSwapPointers_p32( queueMUTEX_HOLDER( pxMutex ), ( void * ) xTaskGetCurrentTaskHandle(), NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
     }
-    #endif
+/*-----------------------------------------------------------*/
 
-    /*lint -save -e904  This function relaxes the coding standard somewhat to
-     * allow return statements within the function itself.  This is done in the
-     * interest of execution time efficiency. */
-    for( ; ; )
+    static BaseType_t prvGiveMutex( Queue_t * const pxMutex )
     {
-        taskENTER_CRITICAL();
+        const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn, xYieldRequired;
+
+        /* Only the holder of a mutex can clear the holder, so the holder cannot
+         * change from the calling task while this function executes. */
+        if( pxMutex->u.xSemaphore.xMutexHolder == xCurrentTask )
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+            traceQUEUE_SEND( pxMutex );
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            pxMutex->uxMessagesWaiting = ( UBaseType_t ) 1;
+            ( void ) Atomic_SwapPointers_p32( queueMUTEX_HOLDER( pxMutex ), NULL );
+
+            /* The calling task can only have inherited a priority while it was
+             * the holder, so once the mutex is released the flag and the
+             * priority together show whether the slow path is needed. */
+            if( ( pxMutex->ulMutexContended == 0U ) && ( xTaskDecrementMutexHeldCount() != pdFALSE ) )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                mtCOVERAGE_TEST_MARKER();
+            }
+            else
+            {
+                queueENTER_CRITICAL( pxMutex );
+                {
+                    /* The mutex held count has not been decremented yet. */
+                    xYieldRequired = xTaskPriorityDisinherit( xCurrentTask );
 
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
+                    if( pxMutex->ulMutexContended != 0U )
+                    {
+                        if( pxMutex->cTxLock != queueUNLOCKED )
+                        {
+                            /* A task is part way through blocking on the mutex.
+                             * Increment the lock count so the task that locked
+                             * the queue knows to unblock a task when it unlocks
+                             * the queue. */
+                            const int8_t cTxLock = pxMutex->cTxLock;
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                            prvIncrementQueueTxLock( pxMutex, cTxLock );
+                        }
+                        else
+                        {
+                            if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToReceive ) ) == pdFALSE )
+                            {
+                                if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaitingToReceive ) ) != pdFALSE )
+                                {
+                                    xYieldRequired = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
 
-                /* The data is being left in the queue, so see if there are
-                 * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            /* The unblocked task sets the flag again if it has to
+                             * block, so once no other task is waiting the mutex
+                             * can go back to the fast path. */
+                            if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                pxMutex->ulMutexContended = 0U;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xYieldRequired != pdFALSE )
                     {
-                        /* The task waiting has a higher priority than this task. */
                         queueYIELD_IF_USING_PREEMPTION();
                     }
                     else
@@ -1929,555 +4858,835 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                queueEXIT_CRITICAL( pxMutex );
+            }
 
-                taskEXIT_CRITICAL();
+            xReturn = pdPASS;
+        }
+        else
+        {
+            /* The mutex is not held, so cannot be given.  A mutex can only be
+             * given by the task that holds it. */
+            configASSERT( pxMutex->u.xSemaphore.xMutexHolder == NULL );
 
-                traceRETURN_xQueuePeek( pdPASS );
+            traceQUEUE_SEND_FAILED( pxMutex );
+            xReturn = errQUEUE_FULL;
+        }
 
-                return pdPASS;
-            }
-            else
-            {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was empty and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+        return xReturn;
+    }
 
-                    traceQUEUE_PEEK_FAILED( pxQueue );
-                    traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
 
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
-                {
-                    /* The queue was empty and a block time was specified so
-                     * configure the timeout structure ready to enter the blocked
-                     * state. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
-                }
-                else
-                {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
+#if ( configUSE_RWLOCKS == 1 )
+
+    static BaseType_t prvRWLockIsAvailable( const Queue_t * const pxRWLock,
+                                            const BaseType_t xForWriting )
+    {
+        BaseType_t xReturn;
+
+        if( pxRWLock->u.xSemaphore.xMutexHolder != NULL )
+        {
+            /* Held for writing, so not available at all. */
+            xReturn = pdFALSE;
+        }
+        else if( xForWriting != pdFALSE )
+        {
+            /* A writer must wait for every reader to give the lock. */
+            xReturn = ( pxRWLock->uxMessagesWaiting == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+        }
+        else if( ( pxRWLock->ucRWLockPreferWriters != ( uint8_t ) pdFALSE ) &&
+                 ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToSend ) ) == pdFALSE ) )
+        {
+            /* New readers queue behind a waiting writer so a stream of readers
+             * cannot hold the writer off indefinitely. */
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            xReturn = pdTRUE;
         }
-        taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now that the critical section has been exited. */
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetRWLockDisinheritPriority( const Queue_t * const pxRWLock )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        UBaseType_t uxPriority;
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+        /* Readers and writers both cause the writer to inherit their priority,
+         * so both lists of waiting tasks are considered. */
+        if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        if( listCURRENT_LIST_LENGTH( &( pxRWLock->xTasksWaitingToSend ) ) > 0U )
         {
-            /* Timeout has not expired yet, check to see if there is data in the
-            * queue now, and if not enter the Blocked state to wait for data. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+            uxPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToSend ) ) );
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+            if( uxPriority > uxHighestPriorityOfWaitingTasks )
+            {
+                uxHighestPriorityOfWaitingTasks = uxPriority;
             }
             else
             {
-                /* There is data in the queue now, so don't enter the blocked
-                 * state, instead return to try and obtain the data. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            /* The timeout has expired.  If there is still no data in the queue
-             * exit, otherwise go back and try to read the data again. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceQUEUE_PEEK_FAILED( pxQueue );
-                traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+        return uxHighestPriorityOfWaitingTasks;
+    }
+/*-----------------------------------------------------------*/
 
-                return errQUEUE_EMPTY;
+    static BaseType_t prvRWLockUnblockWaiters( Queue_t * const pxRWLock )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const BaseType_t xWritersWaiting = ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToSend ) ) == pdFALSE ) ? pdTRUE : pdFALSE;
+        const BaseType_t xReadersWaiting = ( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToReceive ) ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+        if( pxRWLock->u.xSemaphore.xMutexHolder != NULL )
+        {
+            /* Nothing can take the lock while it is held for writing. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else if( ( xWritersWaiting != pdFALSE ) &&
+                 ( pxRWLock->uxMessagesWaiting == ( UBaseType_t ) 0 ) &&
+                 ( ( pxRWLock->ucRWLockPreferWriters != ( uint8_t ) pdFALSE ) ||
+                   ( xReadersWaiting == pdFALSE ) ||
+                   ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToSend ) ) < listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxRWLock->xTasksWaitingToReceive ) ) ) ) )
+        {
+            /* Only one writer can take the lock, so unblock the highest
+             * priority writer.  Event list item values are inverted priorities,
+             * so a lower value is a higher priority. */
+            if( xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                xReturn = pdTRUE;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-    } /*lint -restore */
-}
+        else if( ( xReadersWaiting != pdFALSE ) &&
+                 ( ( pxRWLock->ucRWLockPreferWriters == ( uint8_t ) pdFALSE ) || ( xWritersWaiting == pdFALSE ) ) )
+        {
+            /* Any number of readers can hold the lock, so unblock them all. */
+            while( listLIST_IS_EMPTY( &( pxRWLock->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxRWLock->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_RWLOCKS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    /* This function is called from a critical section. */
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-        /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        #if ( configUSE_MUTEXES == 1 )
         {
-            const int8_t cRxLock = pxQueue->cRxLock;
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held. */
+                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
+    else if( xPosition == queueSEND_TO_BACK )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* If the queue is locked the event list will not be modified.
-             * Instead update the lock count so the task that unlocks the queue
-             * will know that an ISR has removed data while the queue was
-             * locked. */
-            if( cRxLock == queueUNLOCKED )
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than us so
-                         * force a context switch. */
-                        if( pxHigherPriorityTaskWoken != NULL )
-                        {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was removed while it was locked. */
-                prvIncrementQueueRxLock( pxQueue, cRxLock );
+                mtCOVERAGE_TEST_MARKER();
             }
-
-            xReturn = pdPASS;
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-    traceRETURN_xQueueReceiveFromISR( xReturn );
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
-    Queue_t * const pxQueue = xQueue;
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+    }
+}
+/*-----------------------------------------------------------*/
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+#if ( configUSE_QUEUE_SPSC == 1 )
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    static UBaseType_t prvSPSCItemsWaiting( const Queue_t * const pxQueue )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
-        {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+        const UBaseType_t uxWriteIndex = pxQueue->u.xSPSC.uxWriteIndex;
+        const UBaseType_t uxReadIndex = pxQueue->u.xSPSC.uxReadIndex;
+        UBaseType_t uxItemsWaiting;
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
-            xReturn = pdPASS;
+        if( uxWriteIndex >= uxReadIndex )
+        {
+            uxItemsWaiting = uxWriteIndex - uxReadIndex;
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+            uxItemsWaiting = ( ( UBaseType_t ) 2U * pxQueue->uxLength ) - ( uxReadIndex - uxWriteIndex );
         }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
-
-    traceRETURN_xQueuePeekFromISR( xReturn );
 
-    return xReturn;
-}
+        return uxItemsWaiting;
+    }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    traceENTER_uxQueueMessagesWaiting( xQueue );
+    static int8_t * prvSPSCSlot( const Queue_t * const pxQueue,
+                                 UBaseType_t uxIndex )
+    {
+        if( uxIndex >= pxQueue->uxLength )
+        {
+            uxIndex -= pxQueue->uxLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    configASSERT( xQueue );
+        return pxQueue->pcHead + ( uxIndex * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+/*-----------------------------------------------------------*/
 
-    taskENTER_CRITICAL();
+    static UBaseType_t prvSPSCNextIndex( const Queue_t * const pxQueue,
+                                         const UBaseType_t uxIndex )
     {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+        UBaseType_t uxNextIndex = uxIndex + ( UBaseType_t ) 1U;
 
-    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+        if( uxNextIndex == ( ( UBaseType_t ) 2U * pxQueue->uxLength ) )
+        {
+            uxNextIndex = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+        return uxNextIndex;
+    }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    static BaseType_t prvWriteSPSC( Queue_t * const pxQueue,
+                                    const void * const pvItemToQueue )
+    {
+        const UBaseType_t uxWriteIndex = pxQueue->u.xSPSC.uxWriteIndex;
+        BaseType_t xReturn;
 
-    traceENTER_uxQueueSpacesAvailable( xQueue );
+        if( prvSPSCItemsWaiting( pxQueue ) < pxQueue->uxLength )
+        {
+            /* The receiver must have finished reading the slot before its read
+             * index showed the slot to be free. */
+            portMEMORY_BARRIER();
 
-    configASSERT( pxQueue );
+            ( void ) memcpy( ( void * ) prvSPSCSlot( pxQueue, uxWriteIndex ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
-    }
-    taskEXIT_CRITICAL();
+            /* Publish the item only once it has been written, then make sure
+             * the index is visible before the receiver's waiting task is read
+             * by the caller. */
+            portMEMORY_BARRIER();
+            pxQueue->u.xSPSC.uxWriteIndex = prvSPSCNextIndex( pxQueue, uxWriteIndex );
+            portMEMORY_BARRIER();
 
-    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    static BaseType_t prvReadSPSC( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const BaseType_t xJustPeeking )
+    {
+        const UBaseType_t uxReadIndex = pxQueue->u.xSPSC.uxReadIndex;
+        BaseType_t xReturn;
 
-    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+        if( pxQueue->u.xSPSC.uxWriteIndex != uxReadIndex )
+        {
+            /* The sender wrote the item before publishing the write index. */
+            portMEMORY_BARRIER();
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+            ( void ) memcpy( pvBuffer, ( void * ) prvSPSCSlot( pxQueue, uxReadIndex ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
 
-    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+            if( xJustPeeking == pdFALSE )
+            {
+                /* Free the slot only once it has been read, then make sure
+                 * the index is visible before the sender's waiting task is
+                 * read by the caller. */
+                portMEMORY_BARRIER();
+                pxQueue->u.xSPSC.uxReadIndex = prvSPSCNextIndex( pxQueue, uxReadIndex );
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-    traceENTER_vQueueDelete( xQueue );
+    static void prvWaitSPSC( Queue_t * const pxQueue,
+                             TaskHandle_t volatile * const pxWaitingTask,
+                             const BaseType_t xForSpace,
+                             TickType_t xTicksToWait )
+    {
+        BaseType_t xMustBlock;
+
+        /* Clear any notification left over from an earlier wait, then record
+         * this task as waiting before checking the queue again.  The other
+         * side updates its index before reading pxWaitingTask, so either the
+         * check below sees the update or the other side sees this task and
+         * notifies it. */
+        ( void ) xTaskNotifyStateClearIndexed( NULL, configQUEUE_SPSC_NOTIFICATION_INDEX );
+        *pxWaitingTask = xTaskGetCurrentTaskHandle();
+        portMEMORY_BARRIER();
+
+        if( xForSpace != pdFALSE )
+        {
+            xMustBlock = ( prvSPSCItemsWaiting( pxQueue ) == pxQueue->uxLength ) ? pdTRUE : pdFALSE;
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+            if( xMustBlock != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xMustBlock = ( prvSPSCItemsWaiting( pxQueue ) == ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE;
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-    {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+            if( xMustBlock != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        if( xMustBlock != pdFALSE )
         {
-            vPortFree( pxQueue );
+            ( void ) xTaskNotifyWaitIndexed( configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        *pxWaitingTask = NULL;
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSendSPSC( Queue_t * const pxQueue,
+                                   const void * const pvItemToQueue,
+                                   TickType_t xTicksToWait )
     {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        BaseType_t xEntryTimeSet = pdFALSE, xReturn;
+        TaskHandle_t xWaitingTask;
+        TimeOut_t xTimeOut;
 
-    traceRETURN_vQueueDelete();
-}
-/*-----------------------------------------------------------*/
+        for( ; ; )
+        {
+            if( prvWriteSPSC( pxQueue, pvItemToQueue ) != pdFALSE )
+            {
+                traceQUEUE_SEND( pxQueue );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                /* The kernel is only used if the receiver is blocked. */
+                xWaitingTask = pxQueue->xTaskWaitingToReceiveSPSC;
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        traceENTER_uxQueueGetQueueNumber( xQueue );
+                if( xWaitingTask != NULL )
+                {
+                    ( void ) xTaskNotifyIndexed( xWaitingTask, configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+                xReturn = pdPASS;
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* Not in a critical section, so use the version that takes
+                 * one to read the tick count and overflow count together. */
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+            prvWaitSPSC( pxQueue, &( pxQueue->xTaskWaitingToSendSPSC ), pdTRUE, xTicksToWait );
+        }
 
-#endif /* configUSE_TRACE_FACILITY */
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    static BaseType_t prvSendSPSCFromISR( Queue_t * const pxQueue,
+                                          const void * const pvItemToQueue,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
     {
-        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+        BaseType_t xReturn;
+        TaskHandle_t xWaitingTask;
 
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+        if( prvWriteSPSC( pxQueue, pvItemToQueue ) != pdFALSE )
+        {
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-        traceRETURN_vQueueSetQueueNumber();
-    }
+            xWaitingTask = pxQueue->xTaskWaitingToReceiveSPSC;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            if( xWaitingTask != NULL )
+            {
+                ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReceiveSPSC( Queue_t * const pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait,
+                                      const BaseType_t xJustPeeking )
     {
-        traceENTER_ucQueueGetQueueType( xQueue );
+        BaseType_t xEntryTimeSet = pdFALSE, xReturn;
+        TaskHandle_t xWaitingTask;
+        TimeOut_t xTimeOut;
 
-        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+        for( ; ; )
+        {
+            if( prvReadSPSC( pxQueue, pvBuffer, xJustPeeking ) != pdFALSE )
+            {
+                if( xJustPeeking == pdFALSE )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    /* The kernel is only used if the sender is blocked. */
+                    xWaitingTask = pxQueue->xTaskWaitingToSendSPSC;
+
+                    if( xWaitingTask != NULL )
+                    {
+                        ( void ) xTaskNotifyIndexed( xWaitingTask, configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    traceQUEUE_PEEK( pxQueue );
+                }
+
+                xReturn = pdPASS;
+                break;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* Not in a critical section, so use the version that takes
+                 * one to read the tick count and overflow count together. */
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvWaitSPSC( pxQueue, &( pxQueue->xTaskWaitingToReceiveSPSC ), pdFALSE, xTicksToWait );
+        }
+
+        if( xReturn == errQUEUE_EMPTY )
+        {
+            if( xJustPeeking == pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+            }
+            else
+            {
+                traceQUEUE_PEEK_FAILED( pxQueue );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        return xReturn;
     }
-
-#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueItemSize( xQueue );
+    static BaseType_t prvReceiveSPSCFromISR( Queue_t * const pxQueue,
+                                             void * const pvBuffer,
+                                             BaseType_t * const pxHigherPriorityTaskWoken,
+                                             const BaseType_t xJustPeeking )
+    {
+        BaseType_t xReturn;
+        TaskHandle_t xWaitingTask;
 
-    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+        if( prvReadSPSC( pxQueue, pvBuffer, xJustPeeking ) != pdFALSE )
+        {
+            if( xJustPeeking == pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
-    return ( ( Queue_t * ) xQueue )->uxItemSize;
-}
-/*-----------------------------------------------------------*/
+                xWaitingTask = pxQueue->xTaskWaitingToSendSPSC;
 
-UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
-{
-    traceENTER_uxQueueGetQueueLength( xQueue );
+                if( xWaitingTask != NULL )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( xWaitingTask, configQUEUE_SPSC_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_PEEK_FROM_ISR( pxQueue );
+            }
 
-    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            if( xJustPeeking == pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+            else
+            {
+                traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+            }
 
-    return ( ( Queue_t * ) xQueue )->uxLength;
-}
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SPSC */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_QUEUE_BATCH_TRANSFERS == 1 )
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                            const int8_t * pcItems,
+                                            const UBaseType_t uxItemCount )
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        const UBaseType_t uxSpaces = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+        const UBaseType_t uxItemsToCopy = ( uxItemCount < uxSpaces ) ? uxItemCount : uxSpaces;
+        const UBaseType_t uxItemsBeforeWrap = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ) / pxQueue->uxItemSize; /*lint !e946 !e947 MISRA exception justified as pointer subtraction is the cleanest solution. */
+        UBaseType_t uxFirstCopy = uxItemsToCopy;
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        if( uxFirstCopy > uxItemsBeforeWrap )
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+            uxFirstCopy = uxItemsBeforeWrap;
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxHighestPriorityOfWaitingTasks;
-    }
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
-
-    /* This function is called from a critical section. */
-
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, ( size_t ) ( uxFirstCopy * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+        pxQueue->pcWriteTo += ( uxFirstCopy * pxQueue->uxItemSize );                                                                /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
         {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            /* The remaining items, if any, wrap around to the start of the
+             * storage area. */
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+
+            if( uxItemsToCopy > uxFirstCopy )
             {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                const size_t xBytes = ( size_t ) ( ( uxItemsToCopy - uxFirstCopy ) * pxQueue->uxItemSize );
+
+                ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) &( pcItems[ uxFirstCopy * pxQueue->uxItemSize ] ), xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+                pxQueue->pcWriteTo += xBytes;                                                                                              /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_MUTEXES */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxItemsToCopy );
+
+        return uxItemsToCopy;
     }
-    else if( xPosition == queueSEND_TO_BACK )
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                              int8_t * pcBuffer,
+                                              const UBaseType_t uxMaxItems )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        const UBaseType_t uxItemsToCopy = ( uxMaxItems < pxQueue->uxMessagesWaiting ) ? uxMaxItems : pxQueue->uxMessagesWaiting;
+        int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        UBaseType_t uxItemsBeforeWrap;
+        UBaseType_t uxFirstCopy = uxItemsToCopy;
+
+        /* pcReadFrom points to the last item read, so the first item to copy
+         * is the one after it. */
+        if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        uxItemsBeforeWrap = ( UBaseType_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ) / pxQueue->uxItemSize; /*lint !e946 !e947 MISRA exception justified as pointer subtraction is the cleanest solution. */
+
+        if( uxFirstCopy > uxItemsBeforeWrap )
         {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
+            uxFirstCopy = uxItemsBeforeWrap;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-    else
-    {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, ( size_t ) ( uxFirstCopy * pxQueue->uxItemSize ) ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+
+        if( uxItemsToCopy > uxFirstCopy )
         {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+            /* The remaining items wrap around to the start of the storage
+             * area. */
+            const size_t xBytes = ( size_t ) ( ( uxItemsToCopy - uxFirstCopy ) * pxQueue->uxItemSize );
+
+            ( void ) memcpy( ( void * ) &( pcBuffer[ uxFirstCopy * pxQueue->uxItemSize ] ), ( const void * ) pxQueue->pcHead, xBytes ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports. */
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( xBytes - pxQueue->uxItemSize );                                        /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        }
+        else if( uxItemsToCopy > ( UBaseType_t ) 0 )
+        {
+            pxQueue->u.xQueue.pcReadFrom = pcReadFrom + ( ( uxItemsToCopy - ( UBaseType_t ) 1 ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        if( xPosition == queueOVERWRITE )
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxItemsToCopy );
+
+        return uxItemsToCopy;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvUnblockTasksForItems( List_t * const pxEventList,
+                                               const UBaseType_t uxMaxTasks )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        UBaseType_t uxUnblocked;
+
+        for( uxUnblocked = 0U; ( uxUnblocked < uxMaxTasks ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ); uxUnblocked++ )
         {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
             {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
+                xYieldRequired = pdTRUE;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-
-    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
 
-    return xReturn;
-}
+        return xYieldRequired;
+    }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
-{
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    static BaseType_t prvNotifyItemsSent( Queue_t * const pxQueue,
+                                          const UBaseType_t uxItemCount )
     {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        BaseType_t xYieldRequired = pdFALSE;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        if( queueIS_SET_MEMBER( pxQueue ) != pdFALSE )
         {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                UBaseType_t uxItem;
+
+                /* The queue set holds one entry for each item in its member
+                 * queues. */
+                for( uxItem = 0U; uxItem < uxItemCount; uxItem++ )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            xYieldRequired = prvUnblockTasksForItems( &( pxQueue->xTasksWaitingToReceive ), uxItemCount );
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        return xYieldRequired;
     }
-}
+
+#endif /* configUSE_QUEUE_BATCH_TRANSFERS */
 /*-----------------------------------------------------------*/
 
 static void prvUnlockQueue( Queue_t * const pxQueue )
@@ -2488,7 +5697,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
      * removed from the queue while the queue was locked.  When a queue is
      * locked items can be added or removed, but the event lists cannot be
      * updated. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cTxLock = pxQueue->cTxLock;
 
@@ -2566,10 +5775,10 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cTxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     /* Do the same for the Rx lock. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2596,17 +5805,154 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cRxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    static BaseType_t prvSendWithoutKernelLock( Queue_t * const pxQueue,
+                                                const void * pvItemToQueue,
+                                                const BaseType_t xPosition )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        taskENTER_OBJECT_CRITICAL( &( pxQueue->xSpinlock ) );
+        {
+            /* Tasks only add themselves to the event lists while the queue is
+             * locked, so if the queue is unlocked and no task is waiting to
+             * receive then none can start waiting while the spinlock is held.
+             * Giving a mutex can cause a priority to be disinherited, and
+             * sending to a member of a queue set also writes to the set, so
+             * both always use the kernel locks. */
+            if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xPosition == queueOVERWRITE ) ) &&
+                ( queueSEND_IS_RESERVED( pxQueue, xPosition ) == pdFALSE ) &&
+                ( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX ) &&
+                ( queueIS_UNLOCKED( pxQueue ) != pdFALSE ) &&
+                ( queueIS_SET_MEMBER( pxQueue ) == pdFALSE ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+            {
+                traceQUEUE_SEND( pxQueue );
+                ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xPosition );
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_OBJECT_CRITICAL( &( pxQueue->xSpinlock ) );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReceiveWithoutKernelLock( Queue_t * const pxQueue,
+                                                   void * const pvBuffer,
+                                                   const BaseType_t xJustPeeking )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        taskENTER_OBJECT_CRITICAL( &( pxQueue->xSpinlock ) );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Removing an item may unblock a task waiting to send, whereas
+             * peeking leaves the item for any other task waiting to receive.
+             * Taking a mutex updates the mutex holder, so always uses the
+             * kernel locks. */
+            const List_t * const pxWaitingTasks = ( xJustPeeking != pdFALSE ) ? &( pxQueue->xTasksWaitingToReceive ) : &( pxQueue->xTasksWaitingToSend );
+
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                ( queueRECEIVE_IS_RESERVED( pxQueue ) == pdFALSE ) &&
+                ( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX ) &&
+                ( queueIS_UNLOCKED( pxQueue ) != pdFALSE ) &&
+                ( listLIST_IS_EMPTY( pxWaitingTasks ) != pdFALSE ) )
+            {
+                if( xJustPeeking != pdFALSE )
+                {
+                    int8_t * const pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+
+                    prvCopyDataFromQueue( pxQueue, pvBuffer );
+                    traceQUEUE_PEEK( pxQueue );
+                    pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+                }
+                else
+                {
+                    prvCopyDataFromQueue( pxQueue, pvBuffer );
+                    traceQUEUE_RECEIVE( pxQueue );
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+                }
+
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_OBJECT_CRITICAL( &( pxQueue->xSpinlock ) );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvEnterQueueCriticalFromISR( Queue_t * const pxQueue,
+                                                     BaseType_t * const pxKernelLocked )
+    {
+        UBaseType_t uxSavedInterruptStatus = taskENTER_OBJECT_CRITICAL_FROM_ISR( &( pxQueue->xSpinlock ) );
+
+        /* An ISR only accesses the event lists, or the queue set, if the
+         * queue is unlocked.  Tasks only add themselves to the event lists
+         * while the queue is locked, so if the queue is unlocked with empty
+         * event lists, and is not a member of a set, the ISR cannot need the
+         * kernel locks while the queue spinlock is held. */
+        if( ( queueIS_UNLOCKED( pxQueue ) != pdFALSE ) &&
+            ( ( queueIS_SET_MEMBER( pxQueue ) != pdFALSE ) ||
+              ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) ||
+              ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) ) )
+        {
+            /* The kernel locks must be taken before the queue spinlock. */
+            taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( pxQueue->xSpinlock ), uxSavedInterruptStatus );
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            ( void ) taskENTER_OBJECT_CRITICAL_FROM_ISR( &( pxQueue->xSpinlock ) );
+            *pxKernelLocked = pdTRUE;
+        }
+        else
+        {
+            *pxKernelLocked = pdFALSE;
+        }
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExitQueueCriticalFromISR( Queue_t * const pxQueue,
+                                             const BaseType_t xKernelLocked,
+                                             const UBaseType_t uxSavedInterruptStatus )
+    {
+        taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( pxQueue->xSpinlock ), uxSavedInterruptStatus );
+
+        if( xKernelLocked != pdFALSE )
+        {
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_GRANULAR_LOCKS */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueEmpty( Queue_t * const pxQueue )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    queueENTER_OBJECT_CRITICAL( pxQueue );
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueRECEIVE_IS_RESERVED( pxQueue ) != pdFALSE ) )
         {
             xReturn = pdTRUE;
         }
@@ -2615,7 +5961,21 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_OBJECT_CRITICAL( pxQueue );
+
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        /* The count of a mutex is only a copy of the mutex state. */
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            xReturn = ( *queueMUTEX_HOLDER( pxQueue ) != NULL ) ? pdTRUE : pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_MUTEX_FAST_PATH */
 
     return xReturn;
 }
@@ -2630,7 +5990,7 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    if( queueMESSAGES_WAITING( pxQueue ) == ( UBaseType_t ) 0 )
     {
         xReturn = pdTRUE;
     }
@@ -2645,13 +6005,21 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
+static BaseType_t prvIsQueueFull( Queue_t * const pxQueue,
+                                  const BaseType_t xPosition )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    #if ( configUSE_QUEUE_ZERO_COPY == 0 )
+    {
+        /* The position only matters when an item is reserved. */
+        ( void ) xPosition;
+    }
+    #endif
+
+    queueENTER_OBJECT_CRITICAL( pxQueue );
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( queueSEND_IS_RESERVED( pxQueue, xPosition ) != pdFALSE ) )
         {
             xReturn = pdTRUE;
         }
@@ -2660,7 +6028,7 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_OBJECT_CRITICAL( pxQueue );
 
     return xReturn;
 }
@@ -2675,7 +6043,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( queueMESSAGES_WAITING( pxQueue ) == pxQueue->uxLength )
     {
         xReturn = pdTRUE;
     }
@@ -2706,7 +6074,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * between the check to see if the queue is full and blocking on the queue. */
         portDISABLE_INTERRUPTS();
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
             {
                 /* The queue is full - do we want to block or just leave without
                  * posting? */
@@ -3187,7 +6555,19 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
         traceENTER_xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
 
-        taskENTER_CRITICAL();
+        #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        {
+            /* Mutexes are given without entering a critical section, so cannot
+             * notify a queue set. */
+            configASSERT( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType != queueQUEUE_IS_MUTEX );
+        }
+        #endif
+
+        /* SPSC queues notify blocked tasks directly, so cannot notify a queue
+         * set. */
+        configASSERT( queueIS_SPSC( ( Queue_t * ) xQueueOrSemaphore ) == pdFALSE );
+
+        queueENTER_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
         {
             if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
             {
@@ -3206,7 +6586,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                 xReturn = pdPASS;
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
 
         traceRETURN_xQueueAddToSet( xReturn );
 
@@ -3240,12 +6620,12 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         }
         else
         {
-            taskENTER_CRITICAL();
+            queueENTER_CRITICAL( pxQueueOrSemaphore );
             {
                 /* The queue is no longer contained in the set. */
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
             }
-            taskEXIT_CRITICAL();
+            queueEXIT_CRITICAL( pxQueueOrSemaphore );
             xReturn = pdPASS;
         }
 
@@ -3301,6 +6681,10 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
 
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
         /* This function must be called form a critical section. */
 
         /* The following line is not reachable in unit tests because every call
@@ -3309,6 +6693,12 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
         configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            /* The caller holds the kernel locks and the member queue's
+             * spinlock, but the set has its own spinlock. */
+            uxSavedInterruptStatus = taskENTER_OBJECT_CRITICAL_FROM_ISR( &( pxQueueSetContainer->xSpinlock ) );
+        #endif
+
         if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
         {
             const int8_t cTxLock = pxQueueSetContainer->cTxLock;
@@ -3347,6 +6737,10 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( pxQueueSetContainer->xSpinlock ), uxSavedInterruptStatus );
+        #endif
+
         return xReturn;
     }
 
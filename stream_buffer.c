@@ -58,7 +58,18 @@
  * that uses task notifications. */
 /*lint -save -e9026 Function like macros allowed and needed here so they can be overridden. */
 #ifndef sbRECEIVE_COMPLETED
-    #define sbRECEIVE_COMPLETED( pxStreamBuffer )                         \
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                                                                        \
+    do {                                                                                                                     \
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( ( pxStreamBuffer ), &( ( pxStreamBuffer )->xTaskWaitingToSend ) ); \
+                                                                                                                             \
+        if( xTaskToNotify != NULL )                                                                                          \
+        {                                                                                                                    \
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );                                                \
+        }                                                                                                                    \
+    } while( 0 )
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+        #define sbRECEIVE_COMPLETED( pxStreamBuffer )                     \
     vTaskSuspendAll();                                                    \
     {                                                                     \
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )              \
@@ -70,6 +81,7 @@
         }                                                                 \
     }                                                                     \
     ( void ) xTaskResumeAll()
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 #endif /* sbRECEIVE_COMPLETED */
 
 /* If user has provided a per-instance receive complete callback, then
@@ -92,7 +104,19 @@
 #endif /* if ( configUSE_SB_COMPLETED_CALLBACK == 1 ) */
 
 #ifndef sbRECEIVE_COMPLETED_FROM_ISR
-    #define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer,                            \
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer,                                                                \
+                                              pxHigherPriorityTaskWoken )                                                    \
+    do {                                                                                                                     \
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( ( pxStreamBuffer ), &( ( pxStreamBuffer )->xTaskWaitingToSend ) ); \
+                                                                                                                             \
+        if( xTaskToNotify != NULL )                                                                                          \
+        {                                                                                                                    \
+            ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, ( pxHigherPriorityTaskWoken ) );          \
+        }                                                                                                                    \
+    } while( 0 )
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+        #define sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer,                        \
                                           pxHigherPriorityTaskWoken )                \
     do {                                                                             \
         UBaseType_t uxSavedInterruptStatus;                                          \
@@ -110,6 +134,7 @@
         }                                                                            \
         taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     } while( 0 )
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
 #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
@@ -135,7 +160,18 @@
  * implementation that uses task notifications.
  */
 #ifndef sbSEND_COMPLETED
-    #define sbSEND_COMPLETED( pxStreamBuffer )                               \
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define sbSEND_COMPLETED( pxStreamBuffer )                                                                              \
+    do {                                                                                                                        \
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( ( pxStreamBuffer ), &( ( pxStreamBuffer )->xTaskWaitingToReceive ) ); \
+                                                                                                                                \
+        if( xTaskToNotify != NULL )                                                                                             \
+        {                                                                                                                       \
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );                                                   \
+        }                                                                                                                       \
+    } while( 0 )
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+        #define sbSEND_COMPLETED( pxStreamBuffer )                           \
     vTaskSuspendAll();                                                       \
     {                                                                        \
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )              \
@@ -147,6 +183,7 @@
         }                                                                    \
     }                                                                        \
     ( void ) xTaskResumeAll()
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 #endif /* sbSEND_COMPLETED */
 
 /* If user has provided a per-instance send completed callback, then
@@ -170,7 +207,18 @@
 
 
 #ifndef sbSEND_COMPLETE_FROM_ISR
-    #define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )       \
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )                                          \
+    do {                                                                                                                        \
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( ( pxStreamBuffer ), &( ( pxStreamBuffer )->xTaskWaitingToReceive ) ); \
+                                                                                                                                \
+        if( xTaskToNotify != NULL )                                                                                             \
+        {                                                                                                                       \
+            ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, ( pxHigherPriorityTaskWoken ) );             \
+        }                                                                                                                       \
+    } while( 0 )
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+        #define sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )   \
     do {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
@@ -187,6 +235,7 @@
         }                                                                               \
         taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     } while( 0 )
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
 
@@ -238,8 +287,37 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xSpinlock; /* Protects the waiting task handles.  Must remain the last member as it is not cleared when the stream buffer is reset. */
+    #endif
 } StreamBuffer_t;
 
+/*
+ * Critical sections that access the waiting task handles.  When
+ * configUSE_GRANULAR_LOCKS is 1 these are protected by the stream buffer's own
+ * spinlock, which is always taken after the kernel locks, never before them.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define sbENTER_CRITICAL( pxStreamBuffer )                     \
+    do {                                                           \
+        taskENTER_CRITICAL();                                      \
+        taskENTER_OBJECT_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) ); \
+    } while( 0 )
+    #define sbEXIT_CRITICAL( pxStreamBuffer )                      \
+    do {                                                           \
+        taskEXIT_OBJECT_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) ); \
+        taskEXIT_CRITICAL();                                       \
+    } while( 0 )
+    #define sbENTER_OBJECT_CRITICAL( pxStreamBuffer )    taskENTER_OBJECT_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) )
+    #define sbEXIT_OBJECT_CRITICAL( pxStreamBuffer )     taskEXIT_OBJECT_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) )
+#else
+    #define sbENTER_CRITICAL( pxStreamBuffer )           taskENTER_CRITICAL()
+    #define sbEXIT_CRITICAL( pxStreamBuffer )            taskEXIT_CRITICAL()
+    #define sbENTER_OBJECT_CRITICAL( pxStreamBuffer )    taskENTER_CRITICAL()
+    #define sbEXIT_OBJECT_CRITICAL( pxStreamBuffer )     taskEXIT_CRITICAL()
+#endif /* configUSE_GRANULAR_LOCKS */
+
 /*
  * The number of bytes available to be read from the buffer.
  */
@@ -303,6 +381,18 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/*
+ * Returns the task, if any, held in *pxWaitingTask and clears *pxWaitingTask
+ * while holding the stream buffer's spinlock.  The task is notified by the
+ * caller once the spinlock has been released, as notifying a task takes the
+ * kernel locks.  Can be called from tasks and ISRs.
+ */
+    static TaskHandle_t prvTakeWaitingTask( StreamBuffer_t * const pxStreamBuffer,
+                                            TaskHandle_t volatile * const pxWaitingTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -382,6 +472,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( ( ( StreamBuffer_t * ) pvAllocatedMemory )->xSpinlock ) ); /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pvAllocatedMemory ), xIsMessageBuffer );
         }
         else
@@ -464,6 +560,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
              * again. */
             pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( pxStreamBuffer->xSpinlock ) );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
 
             xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
@@ -573,7 +675,7 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
     #endif
 
     /* Can only reset a message buffer if there are no tasks blocked on it. */
-    taskENTER_CRITICAL();
+    sbENTER_OBJECT_CRITICAL( pxStreamBuffer );
     {
         if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
         {
@@ -603,7 +705,7 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             xReturn = pdPASS;
         }
     }
-    taskEXIT_CRITICAL();
+    sbEXIT_OBJECT_CRITICAL( pxStreamBuffer );
 
     traceRETURN_xStreamBufferReset( xReturn );
 
@@ -766,7 +868,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait until the required number of bytes are free in the message
              * buffer. */
-            taskENTER_CRITICAL();
+            sbENTER_CRITICAL( pxStreamBuffer );
             {
                 xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
@@ -781,11 +883,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                 }
                 else
                 {
-                    taskEXIT_CRITICAL();
+                    sbEXIT_CRITICAL( pxStreamBuffer );
                     break;
                 }
             }
-            taskEXIT_CRITICAL();
+            sbEXIT_CRITICAL( pxStreamBuffer );
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
@@ -969,7 +1071,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     {
         /* Checking if there is data and clearing the notification state must be
          * performed atomically. */
-        taskENTER_CRITICAL();
+        sbENTER_CRITICAL( pxStreamBuffer );
         {
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
@@ -992,7 +1094,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        sbEXIT_CRITICAL( pxStreamBuffer );
 
         if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
@@ -1274,21 +1376,21 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
 
     traceENTER_xStreamBufferSendCompletedFromISR( xStreamBuffer, pxHigherPriorityTaskWoken );
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( pxStreamBuffer, &( pxStreamBuffer->xTaskWaitingToReceive ) );
+
+        if( xTaskToNotify != NULL )
         {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+            ( void ) xTaskNotifyFromISR( xTaskToNotify,
                                          ( uint32_t ) 0,
                                          eNoAction,
                                          pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
             xReturn = pdTRUE;
         }
         else
@@ -1296,7 +1398,29 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+            {
+                ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+                                             ( uint32_t ) 0,
+                                             eNoAction,
+                                             pxHigherPriorityTaskWoken );
+                ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 
     traceRETURN_xStreamBufferSendCompletedFromISR( xReturn );
 
@@ -1309,21 +1433,21 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
 
     traceENTER_xStreamBufferReceiveCompletedFromISR( xStreamBuffer, pxHigherPriorityTaskWoken );
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+        const TaskHandle_t xTaskToNotify = prvTakeWaitingTask( pxStreamBuffer, &( pxStreamBuffer->xTaskWaitingToSend ) );
+
+        if( xTaskToNotify != NULL )
         {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+            ( void ) xTaskNotifyFromISR( xTaskToNotify,
                                          ( uint32_t ) 0,
                                          eNoAction,
                                          pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
             xReturn = pdTRUE;
         }
         else
@@ -1331,7 +1455,29 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    #else /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+            {
+                ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+                                             ( uint32_t ) 0,
+                                             eNoAction,
+                                             pxHigherPriorityTaskWoken );
+                ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configUSE_GRANULAR_LOCKS == 1 ) */
 
     traceRETURN_xStreamBufferReceiveCompletedFromISR( xReturn );
 
@@ -1450,6 +1596,27 @@ static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    static TaskHandle_t prvTakeWaitingTask( StreamBuffer_t * const pxStreamBuffer,
+                                            TaskHandle_t volatile * const pxWaitingTask )
+    {
+        TaskHandle_t xWaitingTask;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_OBJECT_CRITICAL_FROM_ISR( &( pxStreamBuffer->xSpinlock ) );
+        {
+            xWaitingTask = *pxWaitingTask;
+            *pxWaitingTask = NULL;
+        }
+        taskEXIT_OBJECT_CRITICAL_FROM_ISR( &( pxStreamBuffer->xSpinlock ), uxSavedInterruptStatus );
+
+        return xWaitingTask;
+    }
+
+#endif /* configUSE_GRANULAR_LOCKS */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           uint8_t * const pucBuffer,
                                           size_t xBufferSizeBytes,
@@ -1471,7 +1638,17 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
     }
     #endif
 
-    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        /* The spinlock is held while a stream buffer is reset, so is not
+         * cleared.  It is initialised when the stream buffer is created. */
+        ( void ) memset( ( void * ) pxStreamBuffer, 0x00, offsetof( StreamBuffer_t, xSpinlock ) ); /*lint !e9087 memset() requires void *. */
+    }
+    #else
+    {
+        ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+    }
+    #endif
     pxStreamBuffer->pucBuffer = pucBuffer;
     pxStreamBuffer->xLength = xBufferSizeBytes;
     pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
@@ -41,6 +41,10 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_ENCODING_FUNCTIONS == 1 ) )
+    #include "stream_buffer.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -80,7 +84,7 @@
 
         #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB ) \
     do {                                                        \
-        if( pxCurrentTCB->uxPriority < ( pxTCB )->uxPriority )  \
+        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )                \
         {                                                       \
             portYIELD_WITHIN_API();                             \
         }                                                       \
@@ -117,6 +121,7 @@
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB     ( ( uint8_t ) 2 )
+#define tskBATCH_ALLOCATED_STACK_AND_TCB          ( ( uint8_t ) 3 )
 
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
@@ -127,6 +132,41 @@
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
 #endif
 
+#if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+
+/* The deepest point a task's stack has reached is recorded in the TCB each
+ * time the task is switched out, which is when pxTopOfStack holds the task's
+ * saved stack pointer.  This makes querying the high water mark O(1), at the
+ * cost of missing any deeper usage that did not coincide with a context
+ * switch - see prvGetIncrementalStackHighWaterMark(). */
+    #if ( portSTACK_GROWTH < 0 )
+        #define taskSAMPLE_STACK_HIGH_WATER_MARK( pxTCB )                              \
+    do {                                                                               \
+        if( ( pxTCB )->pxTopOfStack < ( pxTCB )->pxStackHighWaterMark )                \
+        {                                                                              \
+            ( pxTCB )->pxStackHighWaterMark = ( StackType_t * ) ( pxTCB )->pxTopOfStack; \
+        }                                                                              \
+    } while( 0 )
+    #else
+        #define taskSAMPLE_STACK_HIGH_WATER_MARK( pxTCB )                              \
+    do {                                                                               \
+        if( ( pxTCB )->pxTopOfStack > ( pxTCB )->pxStackHighWaterMark )                \
+        {                                                                              \
+            ( pxTCB )->pxStackHighWaterMark = ( StackType_t * ) ( pxTCB )->pxTopOfStack; \
+        }                                                                              \
+    } while( 0 )
+    #endif /* portSTACK_GROWTH */
+
+/* A stack word that still holds the value it was filled with when the task
+ * was created - tskSTACK_FILL_BYTE repeated in every byte. */
+    #define tskSTACK_FILL_WORD    ( ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0U ) / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE )
+
+#else /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
+
+    #define taskSAMPLE_STACK_HIGH_WATER_MARK( pxTCB )
+
+#endif /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -150,7 +190,47 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* Ready tasks at configEDF_PRIORITY are held in deadline order, so the task
+ * to run at that priority is always the one at the head of the list rather
+ * than the next one in round robin order. */
+    #define taskIS_EDF_PRIORITY( uxPriority )    ( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )
+
+    #define taskGET_NEXT_READY_TASK( pxTCB, uxPriority )                                      \
+    do {                                                                                      \
+        if( taskIS_EDF_PRIORITY( uxPriority ) )                                               \
+        {                                                                                     \
+            ( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) ); \
+        }                                                                                     \
+        else                                                                                  \
+        {                                                                                     \
+            listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), &( pxReadyTasksLists[ ( uxPriority ) ] ) ); \
+        }                                                                                     \
+    } while( 0 )
+
+/* Deadlines are compared using wrapping arithmetic, so xDeadline is before
+ * xOtherDeadline if it is less than half the tick range behind it. */
+    #define taskDEADLINE_IS_BEFORE( xDeadline, xOtherDeadline )    ( ( TickType_t ) ( ( xDeadline ) - ( xOtherDeadline ) ) > ( portMAX_DELAY >> 1 ) )
+
+/* A task preempts the running task if it has a higher priority, or if both
+ * run at configEDF_PRIORITY and the task has the earlier deadline. */
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )                                            \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||                             \
+      ( ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) &&                          \
+        taskIS_EDF_PRIORITY( ( pxTCB )->uxPriority ) &&                                   \
+        ( prvTaskHasEarlierDeadline( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+
+#else /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+
+    #define taskGET_NEXT_READY_TASK( pxTCB, uxPriority )    listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )              ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+#endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_TASK_SELECTION_BITMAP == 0 ) )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -182,7 +262,7 @@
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskGET_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                               \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -199,6 +279,74 @@
     #define taskRESET_READY_PRIORITY( uxPriority )
     #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+
+/* If configUSE_TASK_SELECTION_BITMAP is 1 then task selection is performed
+ * using a portable two level bitmap of the ready priorities, so the cost of
+ * selecting the next task does not depend on configMAX_PRIORITIES.  Bit n of
+ * ulReadyPriorityBitmap[ w ] is set when pxReadyTasksLists[ ( w * 32 ) + n ]
+ * is not empty, and bit w of ulReadyPriorityGroups is set when
+ * ulReadyPriorityBitmap[ w ] is not zero. */
+    #define taskPRIORITY_BITMAP_WORDS                 ( ( ( UBaseType_t ) configMAX_PRIORITIES + 31U ) / 32U )
+    #define taskPRIORITY_BITMAP_WORD( uxPriority )    ( ( UBaseType_t ) ( uxPriority ) >> 5U )
+    #define taskPRIORITY_BITMAP_BIT( uxBit )          ( ( uint32_t ) 1U << ( ( UBaseType_t ) ( uxBit ) & 0x1FU ) )
+
+/* Use the port's count leading zeros instruction when the compiler exposes
+ * one, otherwise fall back to a portable binary search. */
+    #if defined( portFIND_HIGHEST_SET_BIT )
+        #define taskFIND_HIGHEST_SET_BIT( ulBitmap )    portFIND_HIGHEST_SET_BIT( ulBitmap )
+    #elif defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 )
+        #define taskFIND_HIGHEST_SET_BIT( ulBitmap )    ( ( UBaseType_t ) 31U - ( UBaseType_t ) __builtin_clz( ( unsigned int ) ( ulBitmap ) ) )
+    #else
+        #define taskFIND_HIGHEST_SET_BIT( ulBitmap )    prvFindHighestSetBit( ulBitmap )
+        #define taskUSE_PORTABLE_FIND_HIGHEST_SET_BIT
+    #endif
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                                                   \
+    do {                                                                                                              \
+        ulReadyPriorityBitmap[ taskPRIORITY_BITMAP_WORD( uxPriority ) ] |= taskPRIORITY_BITMAP_BIT( uxPriority );     \
+        ulReadyPriorityGroups |= taskPRIORITY_BITMAP_BIT( taskPRIORITY_BITMAP_WORD( uxPriority ) );                   \
+    } while( 0 ) /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                      \
+    do {                                                                                            \
+        UBaseType_t uxTopWord;                                                                      \
+        UBaseType_t uxTopPriority;                                                                  \
+                                                                                                    \
+        /* Find the highest priority list that contains ready tasks.  The idle \
+         * priority bit is always set once the scheduler has started. */                            \
+        configASSERT( ulReadyPriorityGroups != 0U );                                                \
+        uxTopWord = taskFIND_HIGHEST_SET_BIT( ulReadyPriorityGroups );                              \
+        uxTopPriority = ( uxTopWord << 5U ) + taskFIND_HIGHEST_SET_BIT( ulReadyPriorityBitmap[ uxTopWord ] ); \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );     \
+        taskGET_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                                     \
+    } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit for a priority whose ready list has become empty, and the
+ * group bit too if no other priority in the same word is ready.  The second
+ * parameter is only there to match the port optimised macro. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )                                                 \
+    do {                                                                                                              \
+        ulReadyPriorityBitmap[ taskPRIORITY_BITMAP_WORD( uxPriority ) ] &= ~taskPRIORITY_BITMAP_BIT( uxPriority );    \
+                                                                                                                      \
+        if( ulReadyPriorityBitmap[ taskPRIORITY_BITMAP_WORD( uxPriority ) ] == 0U )                                   \
+        {                                                                                                             \
+            ulReadyPriorityGroups &= ~taskPRIORITY_BITMAP_BIT( taskPRIORITY_BITMAP_WORD( uxPriority ) );              \
+        }                                                                                                             \
+    } while( 0 )
+
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    do {                                                                                               \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), 0 );                                             \
+        }                                                                                              \
+    } while( 0 )
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -217,7 +365,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskGET_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                                 \
     } while( 0 )
 
 /*-----------------------------------------------------------*/
@@ -237,9 +385,11 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
+    #define taskSWITCH_DELAYED_LISTS()                                            \
     do {                                                                          \
         List_t * pxTemp;                                                          \
                                                                                   \
@@ -253,19 +403,131 @@
         prvResetNextTaskUnblockTime();                                            \
     } while( 0 )
 
+/* Returns pdTRUE if pxList is one of the lists that hold Blocked tasks in wake
+ * time order. */
+    #define taskLIST_IS_DELAYED_LIST( pxList ) \
+    ( ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) ) ? pdTRUE : pdFALSE )
+
+#else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+
+/* The delayed task wheel buckets are indexed by the low bits of the wake time
+ * so there is nothing to switch when the tick count overflows - it is only
+ * necessary to recalculate xNextTaskUnblockTime, which is held as an absolute
+ * tick value. */
+    #define taskSWITCH_DELAYED_LISTS() \
+    do {                               \
+        xNumOfOverflows++;             \
+        prvResetNextTaskUnblockTime(); \
+    } while( 0 )
+
+/* Number of buckets in each level of the delayed task wheel, and the mask used
+ * to obtain a bucket index from a tick value. */
+    #define taskWHEEL_BUCKETS_PER_LEVEL    ( ( UBaseType_t ) 1U << configTIMING_WHEEL_BITS_PER_LEVEL )
+    #define taskWHEEL_BUCKET_MASK          ( ( TickType_t ) taskWHEEL_BUCKETS_PER_LEVEL - ( TickType_t ) 1U )
+
+/* The number of bits a tick value is shifted right by to obtain the bucket
+ * index at level uxLevel.  Level configTIMING_WHEEL_LEVELS is the overflow
+ * list that holds tasks whose wake time is beyond the span of the wheel. */
+    #define taskWHEEL_LEVEL_SHIFT( uxLevel )    ( ( UBaseType_t ) ( uxLevel ) * ( UBaseType_t ) configTIMING_WHEEL_BITS_PER_LEVEL )
+
+    #define taskLIST_IS_DELAYED_LIST( pxList )                                                                                \
+    ( ( ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) &&                                                               \
+          ( ( pxList ) <= &( xDelayedTaskWheel[ configTIMING_WHEEL_LEVELS - 1 ][ taskWHEEL_BUCKETS_PER_LEVEL - 1U ] ) ) ) || \
+        ( ( pxList ) == &xDelayedTaskWheelOverflow ) ) ? pdTRUE : pdFALSE )
+
+#endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) && ( ( configUSE_DYNAMIC_TICK == 1 ) || ( configUSE_TICKLESS_IDLE != 0 ) ) )
+
+/* The most ticks that can be suppressed while still reading the run time
+ * counter often enough for prvGetRunTimeCounterValue() to see every wrap of its
+ * low 32 bits. */
+    #define taskRUN_TIME_COUNTER_MAX_SUPPRESSED_TICKS    ( ( TickType_t ) ( configRUN_TIME_COUNTER_WRAP_TICKS / 4U ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
+/*
+ * When configUSE_DYNAMIC_TICK is 1 a task made ready at the priority of the
+ * running task means the running task must now be time sliced, so the next tick
+ * interrupt may need to be brought forward.
+ */
+#if ( ( configUSE_DYNAMIC_TICK == 1 ) && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+    #define taskDYNAMIC_TICK_TASK_READIED( pxTCB )                                 \
+    do {                                                                           \
+        if( ( xSchedulerRunning != pdFALSE ) &&                                    \
+            ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) &&               \
+            ( ( xNextTickInterrupt - ( xTickCount + xPendedTicks ) ) > ( TickType_t ) 1U ) ) \
+        {                                                                          \
+            prvSetNextTickInterrupt();                                             \
+        }                                                                          \
+    } while( 0 )
+#else
+    #define taskDYNAMIC_TICK_TASK_READIED( pxTCB )
+#endif
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                     \
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                     \
+    do {                                                                                                   \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
+                                                                                                           \
+        if( taskIS_EDF_PRIORITY( ( pxTCB )->uxPriority ) )                                                 \
+        {                                                                                                  \
+            prvInsertTaskByDeadline( pxTCB );                                                              \
+        }                                                                                                  \
+        else                                                                                               \
+        {                                                                                                  \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                  \
+                                                                                                           \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+        taskDYNAMIC_TICK_TASK_READIED( pxTCB );                                                            \
+    } while( 0 )
+#elif ( configUSE_PER_CORE_READY_LISTS == 1 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                \
+    do {                                                                                              \
+        List_t * const pxTaskReadyList = prvGetReadyListForTask( ( pxTCB ), ( pxTCB )->uxPriority ); \
+                                                                                                      \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                           \
+        listINSERT_END( pxTaskReadyList, &( ( pxTCB )->xStateListItem ) );                            \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                 \
+    } while( 0 )
+#else
+    #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
         taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+        taskDYNAMIC_TICK_TASK_READIED( pxTCB );                                                            \
     } while( 0 )
+#endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+
+/*
+ * Returns the ready list in which pxTCB is held while at priority uxPriority.
+ */
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    #define taskGET_READY_LIST( pxTCB, uxPriority )    prvGetReadyListForTask( ( pxTCB ), ( uxPriority ) )
+#else
+    #define taskGET_READY_LIST( pxTCB, uxPriority )    ( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+#endif
+
+/*
+ * Returns the number of tasks in the Ready state at priority uxPriority.
+ */
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    #define taskREADY_TASK_COUNT( uxPriority )    prvGetReadyTaskCount( uxPriority )
+#else
+    #define taskREADY_TASK_COUNT( uxPriority )    listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -310,11 +572,24 @@
 /* Indicates that the task is an Idle task. */
 #define taskATTRIBUTE_IS_IDLE    ( UBaseType_t ) ( 1UL << 0UL )
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* The TCB of the task running on the calling core.  Unless the port keeps the
+ * running task in core-local storage, interrupts must be disabled while this is
+ * used, so the calling task cannot move to another core between reading the
+ * core ID and reading pxCurrentTCBs[]. */
+    #ifdef portGET_CURRENT_TCB
+        #define taskGET_CURRENT_TCB_FOR_THIS_CORE()    ( ( TCB_t * ) portGET_CURRENT_TCB() )
+    #else
+        #define taskGET_CURRENT_TCB_FOR_THIS_CORE()    ( pxCurrentTCBs[ portGET_CORE_ID() ] )
+    #endif
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( portCRITICAL_NESTING_IN_TCB == 1 ) )
-    #define portGET_CRITICAL_NESTING_COUNT()          ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting )
-    #define portSET_CRITICAL_NESTING_COUNT( x )       ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting = ( x ) )
-    #define portINCREMENT_CRITICAL_NESTING_COUNT()    ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting++ )
-    #define portDECREMENT_CRITICAL_NESTING_COUNT()    ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting-- )
+    #define portGET_CRITICAL_NESTING_COUNT()          ( taskGET_CURRENT_TCB_FOR_THIS_CORE()->uxCriticalNesting )
+    #define portSET_CRITICAL_NESTING_COUNT( x )       ( taskGET_CURRENT_TCB_FOR_THIS_CORE()->uxCriticalNesting = ( x ) )
+    #define portINCREMENT_CRITICAL_NESTING_COUNT()    ( taskGET_CURRENT_TCB_FOR_THIS_CORE()->uxCriticalNesting++ )
+    #define portDECREMENT_CRITICAL_NESTING_COUNT()    ( taskGET_CURRENT_TCB_FOR_THIS_CORE()->uxCriticalNesting-- )
 #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( portCRITICAL_NESTING_IN_TCB == 1 ) ) */
 
 #define taskBITS_PER_BYTE    ( ( size_t ) 8 )
@@ -369,17 +644,53 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         volatile BaseType_t xTaskRunState;      /**< Used to identify the core the task is running on, if the task is running. Otherwise, identifies the task's state - not running or yielding. */
         UBaseType_t uxTaskAttributes;           /**< Task's attributes - currently used to identify the idle tasks. */
     #endif
+
+    /* When configTCB_CACHE_LINE_SIZE is not 0 the members used by the
+     * scheduler, the tick interrupt and the mutex code are grouped above, and
+     * the members that are rarely accessed while the task runs start on the
+     * next cache line.  The grouped members must be kept in step with
+     * struct xSTATIC_TCB_HOT_MEMBERS in FreeRTOS.h. */
+    #if ( configTCB_CACHE_LINE_SIZE > 0 )
+        #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+            BaseType_t xPreemptionDisable; /**< Used to prevent the task from being preempted. */
+        #endif
+
+        #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            StackType_t * pxEndOfStack; /**< Points to the highest valid address for the stack. */
+        #endif
+
+        #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            UBaseType_t uxCriticalNesting; /**< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
+        #endif
+
+        #if ( configUSE_MUTEXES == 1 )
+            UBaseType_t uxBasePriority; /**< The priority last assigned to the task - used by the priority inheritance mechanism. */
+            UBaseType_t uxMutexesHeld;
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
+        #endif
+
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+            TickType_t xDeadline;    /**< The tick count by which the task's current job should complete.  Only valid if xHasDeadline is pdTRUE. */
+            BaseType_t xHasDeadline; /**< Set to pdTRUE once the task has been given a deadline. */
+        #endif
+
+        uint8_t ucCacheLinePadding[ tskTCB_CACHE_LINE_PADDING ]; /**< Starts the members below on a cache line boundary. */
+    #endif /* if ( configTCB_CACHE_LINE_SIZE > 0 ) */
+
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /**< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
-    #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+    #if ( ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         BaseType_t xPreemptionDisable; /**< Used to prevent the task from being preempted. */
     #endif
 
-    #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+    #if ( ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         StackType_t * pxEndOfStack; /**< Points to the highest valid address for the stack. */
     #endif
 
-    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    #if ( ( portCRITICAL_NESTING_IN_TCB == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         UBaseType_t uxCriticalNesting; /**< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
     #endif
 
@@ -388,7 +699,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxTaskNumber; /**< Stores a number specifically for use by third party trace code. */
     #endif
 
-    #if ( configUSE_MUTEXES == 1 )
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         UBaseType_t uxBasePriority; /**< The priority last assigned to the task - used by the priority inheritance mechanism. */
         UBaseType_t uxMutexesHeld;
     #endif
@@ -401,7 +712,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         void * pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
 
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
     #endif
 
@@ -427,6 +738,38 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_TASK_NAME_INDEX == 1 )
+        struct tskTaskControlBlock * pxNextInNameIndex; /**< Links tasks whose names share a bucket in the task name index. */
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULING == 1 ) && ( configTCB_CACHE_LINE_SIZE == 0 ) )
+        TickType_t xDeadline;    /**< The tick count by which the task's current job should complete.  Only valid if xHasDeadline is pdTRUE. */
+        BaseType_t xHasDeadline; /**< Set to pdTRUE once the task has been given a deadline. */
+    #endif
+
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        TickType_t xBudget;            /**< The number of ticks the task may run for in each budget period, or 0 if the task does not have a budget. */
+        TickType_t xBudgetPeriod;      /**< The length of the budget period in ticks. */
+        TickType_t xBudgetRemaining;   /**< The number of ticks the task may still run for in the current period. */
+        TickType_t xBudgetPeriodStart; /**< The tick count at which the current budget period started. */
+    #endif
+
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+        StackType_t * pxStackHighWaterMark; /**< The deepest stack location known to have been used by the task. */
+    #endif
+
+    #if ( configUSE_TASK_SNAPSHOTS == 1 )
+        UBaseType_t uxSnapshotIndex; /**< The task's entry in the snapshot table, or taskSNAPSHOT_INDEX_NONE if the table was full when the task was created. */
+    #endif
+
+    #if ( ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+        configRUN_TIME_COUNTER_TYPE ulRunTimeCounterPerCore[ configNUMBER_OF_CORES ]; /**< Stores the amount of time the task has spent in the Running state on each core. */
+    #endif
+
+    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+        void * volatile pvBlockingMutex; /**< The mutex the task is blocked on, or NULL if the task is not blocked on a mutex. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -442,7 +785,12 @@ typedef tskTCB TCB_t;
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-84 */
     /* coverity[misra_c_2012_rule_8_4_violation] */
     portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
-    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+
+    #ifdef portGET_CURRENT_TCB
+        #define pxCurrentTCB    taskGET_CURRENT_TCB_FOR_THIS_CORE()
+    #else
+        #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+    #endif
 #endif
 
 /* Lists for ready and blocked tasks. --------------------
@@ -450,10 +798,18 @@ typedef tskTCB TCB_t;
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /**< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    PRIVILEGED_DATA static List_t pxCoreReadyTasksLists[ configNUMBER_OF_CORES ][ configMAX_PRIORITIES ]; /**< Prioritised ready tasks that can only run on one core. */
+#endif
+#if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                    /**< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                    /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;         /**< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList; /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#else
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configTIMING_WHEEL_LEVELS ][ taskWHEEL_BUCKETS_PER_LEVEL ]; /**< Delayed tasks, hashed by wake time.  Each level 0 bucket holds tasks that all wake on the same tick. */
+    PRIVILEGED_DATA static List_t xDelayedTaskWheelOverflow;                                                     /**< Delayed tasks whose wake time is beyond the span of the wheel. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -469,6 +825,32 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 
 #endif
 
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+    PRIVILEGED_DATA static TCB_t * pxTaskNameIndex[ configTASK_NAME_INDEX_SIZE ]; /**< Hash table of task names used by xTaskGetHandle().  Each bucket is the head of a list linked through pxNextInNameIndex. */
+
+#endif
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+/* An entry in the table read by uxTaskGetSnapshot().  ulSequence is odd while
+ * the entry is being updated, and is incremented twice by every update, so a
+ * reader that sees the same even value before and after copying xSnapshot
+ * knows the copy is consistent. */
+    typedef struct xTASK_SNAPSHOT_ENTRY
+    {
+        uint32_t ulSequence;
+        TaskSnapshot_t xSnapshot;
+    } TaskSnapshotEntry_t;
+
+    PRIVILEGED_DATA static volatile TaskSnapshotEntry_t xTaskSnapshots[ configTASK_SNAPSHOT_TABLE_SIZE ]; /**< Task state published at each context switch.  Entries with a NULL handle are free. */
+
+/* The value of uxSnapshotIndex for a task that does not have an entry in the
+ * snapshot table. */
+    #define taskSNAPSHOT_INDEX_NONE    ( ( UBaseType_t ) configTASK_SNAPSHOT_TABLE_SIZE )
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -478,13 +860,31 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_TASK_SELECTION_BITMAP == 1 )
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0U;
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityBitmap[ taskPRIORITY_BITMAP_WORDS ] = { 0U };
+#else
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    PRIVILEGED_DATA static TaskDeadlineStats_t xDeadlineStats = { 0U, 0U, 0U };
+#endif
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/* The number of the critical nesting levels on each core that were entered
+ * by taking an object spinlock rather than the kernel locks. */
+    PRIVILEGED_DATA static UBaseType_t uxObjectCriticalNesting[ configNUMBER_OF_CORES ] = { 0U };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    PRIVILEGED_DATA static TickType_t xNextTickInterrupt = ( TickType_t ) 0U; /**< The tick count at which the next tick interrupt has been requested. */
+#endif
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];       /**< Holds the handles of the idle tasks.  The idle tasks are created automatically when the scheduler is started. */
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
@@ -513,6 +913,11 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0U };    /**< Holds the value of a timer/counter the last time a task was switched in. */
 PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ configNUMBER_OF_CORES ] = { 0U }; /**< Holds the total amount of execution time as defined by the run time counter clock. */
 
+    #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulLastRunTimeCounterValue = 0U;                               /**< Holds the extended value of the run time counter the last time it moved forward.  Shared by all cores and only accessed with the kernel lock held. */
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCoreIdleRunTime[ configNUMBER_OF_CORES ] = { 0U };          /**< Holds the amount of time each core has spent running an idle task. */
+    #endif
+
 #endif
 
 /*lint -restore */
@@ -617,6 +1022,16 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * As prvAddCurrentTaskToDelayedList(), but xTicksToWait is relative to
+ * xTimeNow rather than to the current tick count.  Used where the caller has
+ * already read the tick count, or is processing a tick and so must not include
+ * ticks that have not yet been processed.
+ */
+static void prvAddCurrentTaskToDelayedListFrom( const TickType_t xTimeNow,
+                                                TickType_t xTicksToWait,
+                                                const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -637,24 +1052,78 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
  */
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 0 )
 
     static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
                                                      const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Returns the bucket of the task name index that a task with the name pcName
+ * is referenced from, and adds or removes a task from the index.  The index is
+ * updated from within a critical section.
+ */
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+    static UBaseType_t prvTaskNameIndexBucket( const char pcName[] ) PRIVILEGED_FUNCTION;
+
+    static void prvAddTaskToNameIndex( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+        static void prvRemoveTaskFromNameIndex( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif /* configUSE_TASK_NAME_INDEX */
+
+/*
+ * Claim and release an entry in the task snapshot table, and publish a task's
+ * current state to its entry.  Entries are only written from within a critical
+ * section or from vTaskSwitchContext(), so there is only ever one writer.
+ */
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+    static void prvAllocateTaskSnapshot( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+        static void prvReleaseTaskSnapshot( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+    static void prvPublishTaskSnapshot( const TCB_t * pxTCB,
+                                        eTaskState eState ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the state of a task that is not running.  Unlike eTaskGetState() it
+ * does not enter a critical section so can be called from vTaskSwitchContext().
+ */
+    static eTaskState prvGetSnapshotTaskState( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+
 /*
  * When a task is created, the stack of the task is filled with a known value.
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 0 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
 
     static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Used in place of prvTaskCheckFreeStackSpace() when
+ * configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is 1.  Returns the high water
+ * mark recorded in the TCB, first extending it with a word-wise scan that
+ * resumes from the previous mark if configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN
+ * is 1.
+ */
+#if ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
+
+    static configSTACK_DEPTH_TYPE prvGetIncrementalStackHighWaterMark( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state.
@@ -670,12 +1139,135 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+#if defined( taskUSE_PORTABLE_FIND_HIGHEST_SET_BIT )
+
+/*
+ * Return the index of the most significant set bit in ulBitmap, which must
+ * not be zero.  Only used by the bitmap task selection when the compiler
+ * does not provide a count leading zeros builtin.
+ */
+    static UBaseType_t prvFindHighestSetBit( uint32_t ulBitmap ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+
+/*
+ * Returns the ready list for priority uxPriority in which pxTCB belongs.  That
+ * is the list of the one core pxTCB is allowed to run on, if its affinity mask
+ * only allows one core, otherwise the shared list.
+ */
+    static List_t * prvGetReadyListForTask( const TCB_t * pxTCB,
+                                            UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of tasks in the shared and per core ready lists for
+ * priority uxPriority.
+ */
+    static UBaseType_t prvGetReadyTaskCount( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+/*
+ * Charge the running task for the tick that has just occurred, replenishing
+ * its budget first if a new period has started.  If the budget is used up the
+ * task is blocked until its next period starts and pdTRUE is returned to
+ * indicate that a context switch is required.  Called from
+ * xTaskIncrementTick().
+ */
+    static BaseType_t prvChargeCurrentTaskBudget( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_TASK_BUDGETS == 1 ) */
+
+#if ( ( configUSE_FAST_TICK_CATCH_UP == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
+
+/*
+ * Process xTicksToCatchUp ticks that occurred while the scheduler was
+ * suspended, or while the tick interrupt was suppressed.  Ticks at which nothing is due are skipped by moving xTickCount
+ * forward directly, so xTaskIncrementTick() is only called for ticks at which
+ * a task unblocks, the tick count overflows, or the last pended tick.  The cost
+ * is therefore proportional to the number of tasks woken rather than the number
+ * of ticks pended.  Returns pdTRUE if a context switch is required.
+ */
+    static BaseType_t prvCatchUpPendedTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( ( configUSE_FAST_TICK_CATCH_UP == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) ) */
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/*
+ * Calculate the number of ticks until the scheduler next needs to run - the
+ * next task unblock time, the end of the running task's time slice or budget -
+ * and ask the port to generate the next tick interrupt at that time.
+ */
+    static void prvSetNextTickInterrupt( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the tick count including ticks that have elapsed but have not yet
+ * been processed, either because the scheduler is suspended or because they
+ * have not yet been announced by the port.  Used wherever a tick count is
+ * returned to the application or a wake time is calculated.  Must only be
+ * called from a task, never while a tick is being processed.
+ */
+    static TickType_t prvGetTickCountNow( void ) PRIVILEGED_FUNCTION;
+
+    #define taskGET_TICK_COUNT_NOW()    prvGetTickCountNow()
+#else
+    #define taskGET_TICK_COUNT_NOW()    ( xTickCount )
+#endif /* #if ( configUSE_DYNAMIC_TICK == 1 ) */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if pxTCB should run before pxOtherTCB when both are ready at
+ * configEDF_PRIORITY.  Tasks without a deadline run before tasks with one.
+ */
+    static BaseType_t prvTaskHasEarlierDeadline( const TCB_t * const pxTCB,
+                                                 const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert pxTCB into the configEDF_PRIORITY ready list after all the tasks
+ * whose deadline is not later than its own.
+ */
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give pxTCB a deadline xRelativeDeadline ticks from now, recording whether
+ * the deadline it replaces was met.  Does not reposition the task in the
+ * ready list.  Must be called from a critical section.
+ */
+    static void prvSetTaskDeadline( TCB_t * const pxTCB,
+                                    TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+
+#if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
+
+/*
+ * Place a task's state list item, the value of which must already hold the
+ * task's wake time, into the delayed task wheel bucket that covers that wake
+ * time.  This is O(1), whereas vListInsert() walks the delayed list.
+ */
+    static void prvInsertIntoDelayedWheel( ListItem_t * const pxListItem,
+                                           const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called each time the lower levels of the delayed task wheel complete a
+ * revolution to move tasks from the higher level bucket that has just come due
+ * into the lower levels.
+ */
+    static void prvCascadeDelayedWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMING_WHEEL_DELAY_LIST */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -706,6 +1298,43 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Move a blocked task whose priority has changed to the position in the
+ * priority ordered event list it is waiting on that matches its new priority,
+ * so tasks waiting on a mutex held by the task are still unblocked in priority
+ * order.  Must be called from a critical section.
+ */
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+    static void prvReorderEventListItem( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Read the run time counter and extend it to 64 bits by counting the number
+ * of times its low 32 bits have wrapped.  The extension is shared by all cores,
+ * so this must be called with the kernel lock held - from a critical section,
+ * or with interrupts masked.
+ */
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * The part of prvAddNewTaskToReadyList() that updates the kernel's task
+ * bookkeeping and places the task in its ready list.  Must be called from
+ * within a critical section, and does not yield.
+ */
+static void prvRegisterNewTask( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Carve the TCB and stack of the next task in a batch out of the block
+ * allocated by xTaskCreateBatch(), advancing *ppucNextFree past them.
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TASK_BATCH_CREATION == 1 ) )
+    static TCB_t * prvCarveBatchTask( uint8_t ** ppucNextFree,
+                                      configSTACK_DEPTH_TYPE usStackDepth,
+                                      StackType_t ** ppxStack ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
  * the task if it is created successfully. Otherwise, returns NULL.
@@ -807,7 +1436,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
         /* This function is always called with interrupts disabled
          * so this is safe. */
-        pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+        pxThisTCB = taskGET_CURRENT_TCB_FOR_THIS_CORE();
 
         while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
         {
@@ -1001,11 +1630,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
          *
          * To fix these problems, the running task should be put to the end of the
          * ready list before searching for the ready task in the ready list. */
-        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+        if( listIS_CONTAINED_WITHIN( taskGET_READY_LIST( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->uxPriority ),
                                      &pxCurrentTCBs[ xCoreID ]->xStateListItem ) == pdTRUE )
         {
             ( void ) uxListRemove( &pxCurrentTCBs[ xCoreID ]->xStateListItem );
-            vListInsertEnd( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+            vListInsertEnd( taskGET_READY_LIST( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->uxPriority ),
                             &pxCurrentTCBs[ xCoreID ]->xStateListItem );
         }
 
@@ -1023,76 +1652,98 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif
 
-            if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
+            if( taskREADY_TASK_COUNT( uxCurrentPriority ) != ( UBaseType_t ) 0U )
             {
-                const List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
-                const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
+                #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+                    /* This core's own ready list is searched before the shared
+                     * list.  Tasks that can only run on other cores are never
+                     * examined. */
+                    const List_t * pxReadyList = &( pxCoreReadyTasksLists[ xCoreID ][ uxCurrentPriority ] );
+                #else
+                    const List_t * pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+                #endif
+                const ListItem_t * pxEndMarker;
                 ListItem_t * pxIterator;
 
-                /* The ready task list for uxCurrentPriority is not empty, so uxTopReadyPriority
+                /* The ready task lists for uxCurrentPriority are not empty, so uxTopReadyPriority
                  * must not be decremented any further. */
                 xDecrementTopPriority = pdFALSE;
 
-                for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                do
                 {
-                    TCB_t * pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+                    pxEndMarker = listGET_END_MARKER( pxReadyList );
 
-                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                    for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
                     {
-                        /* When falling back to the idle priority because only one priority
-                         * level is allowed to run at a time, we should ONLY schedule the true
-                         * idle tasks, not user tasks at the idle priority. */
-                        if( uxCurrentPriority < uxTopReadyPriority )
+                        TCB_t * pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+                        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
                         {
-                            if( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0 )
+                            /* When falling back to the idle priority because only one priority
+                             * level is allowed to run at a time, we should ONLY schedule the true
+                             * idle tasks, not user tasks at the idle priority. */
+                            if( uxCurrentPriority < uxTopReadyPriority )
                             {
-                                continue;
+                                if( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0 )
+                                {
+                                    continue;
+                                }
                             }
                         }
-                    }
-                    #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
+                        #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
 
-                    if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
-                    {
-                        #if ( configUSE_CORE_AFFINITY == 1 )
-                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                        #endif
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
                         {
-                            /* If the task is not being executed by any core swap it in. */
-                            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
                             #if ( configUSE_CORE_AFFINITY == 1 )
-                                pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
                             #endif
-                            pxTCB->xTaskRunState = xCoreID;
-                            pxCurrentTCBs[ xCoreID ] = pxTCB;
-                            xTaskScheduled = pdTRUE;
+                            {
+                                /* If the task is not being executed by any core swap it in. */
+                                pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                                #if ( configUSE_CORE_AFFINITY == 1 )
+                                    pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                                #endif
+                                pxTCB->xTaskRunState = xCoreID;
+                                pxCurrentTCBs[ xCoreID ] = pxTCB;
+                                xTaskScheduled = pdTRUE;
+                            }
                         }
-                    }
-                    else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
-                    {
-                        configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+                        else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                        {
+                            configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
 
-                        #if ( configUSE_CORE_AFFINITY == 1 )
-                            if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                        #endif
+                            #if ( configUSE_CORE_AFFINITY == 1 )
+                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                            #endif
+                            {
+                                /* The task is already running on this core, mark it as scheduled. */
+                                pxTCB->xTaskRunState = xCoreID;
+                                xTaskScheduled = pdTRUE;
+                            }
+                        }
+                        else
+                        {
+                            /* This task is running on the core other than xCoreID. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( xTaskScheduled != pdFALSE )
                         {
-                            /* The task is already running on this core, mark it as scheduled. */
-                            pxTCB->xTaskRunState = xCoreID;
-                            xTaskScheduled = pdTRUE;
+                            /* A task has been selected to run on this core. */
+                            break;
                         }
                     }
-                    else
+
+                    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
                     {
-                        /* This task is running on the core other than xCoreID. */
-                        mtCOVERAGE_TEST_MARKER();
+                        pxReadyList = ( pxReadyList != &( pxReadyTasksLists[ uxCurrentPriority ] ) ) ? &( pxReadyTasksLists[ uxCurrentPriority ] ) : NULL;
                     }
-
-                    if( xTaskScheduled != pdFALSE )
+                    #else
                     {
-                        /* A task has been selected to run on this core. */
-                        break;
+                        pxReadyList = NULL;
                     }
-                }
+                    #endif
+                } while( ( xTaskScheduled == pdFALSE ) && ( pxReadyList != NULL ) );
             }
             else
             {
@@ -1150,7 +1801,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         {
             if( xTaskScheduled == pdTRUE )
             {
-                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( taskGET_READY_LIST( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
                 {
                     /* A ready task was just evicted from this core. See if it can be
                      * scheduled on any other core. */
@@ -1264,6 +1915,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             volatile size_t xSize = sizeof( StaticTask_t );
             configASSERT( xSize == sizeof( TCB_t ) );
             ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+
+            /* Check the members that are rarely accessed start on a cache
+             * line boundary relative to the start of the TCB. */
+            #if ( configTCB_CACHE_LINE_SIZE > 0 )
+                configASSERT( ( offsetof( TCB_t, pcTaskName ) % configTCB_CACHE_LINE_SIZE ) == 0U );
+            #endif
         }
         #endif /* configASSERT_DEFINED */
 
@@ -1725,6 +2382,46 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        BaseType_t xTaskCreateWithDeadline( TaskFunction_t pxTaskCode,
+                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            const configSTACK_DEPTH_TYPE usStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xRelativeDeadline,
+                                            TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
+
+            traceENTER_xTaskCreateWithDeadline( pxTaskCode, pcName, usStackDepth, pvParameters, xRelativeDeadline, pxCreatedTask );
+
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, configEDF_PRIORITY, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
+            {
+                /* The deadline must be set before the task is placed in the
+                 * deadline ordered ready list. */
+                taskENTER_CRITICAL();
+                {
+                    prvSetTaskDeadline( pxNewTCB, xRelativeDeadline );
+                }
+                taskEXIT_CRITICAL();
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+            }
+
+            traceRETURN_xTaskCreateWithDeadline( xReturn );
+
+            return xReturn;
+        }
+    #endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -1759,6 +2456,204 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             return xReturn;
         }
     #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TASK_BATCH_CREATION == 1 )
+
+/* Round a size up to the port's byte alignment so that every TCB and stack
+ * carved out of a batch allocation keeps the alignment pvPortMalloc()
+ * guarantees. */
+        #define taskBATCH_ALIGNED_SIZE( xSize )    ( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+        static TCB_t * prvCarveBatchTask( uint8_t ** ppucNextFree,
+                                          configSTACK_DEPTH_TYPE usStackDepth,
+                                          StackType_t ** ppxStack )
+        {
+            TCB_t * pxNewTCB;
+
+            /* As in prvCreateTask(), place the stack below the TCB if the stack
+             * grows down and above it if the stack grows up, so a task cannot
+             * overflow its stack into its own TCB. */
+            #if ( portSTACK_GROWTH > 0 )
+            {
+                pxNewTCB = ( TCB_t * ) *ppucNextFree; /*lint !e9087 !e826 The block was allocated with enough space for the TCB and is suitably aligned. */
+                *ppucNextFree += taskBATCH_ALIGNED_SIZE( sizeof( TCB_t ) );
+                *ppxStack = ( StackType_t * ) *ppucNextFree; /*lint !e9087 !e826 The block was allocated with enough space for the stack and is suitably aligned. */
+                *ppucNextFree += taskBATCH_ALIGNED_SIZE( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) );
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                *ppxStack = ( StackType_t * ) *ppucNextFree; /*lint !e9087 !e826 The block was allocated with enough space for the stack and is suitably aligned. */
+                *ppucNextFree += taskBATCH_ALIGNED_SIZE( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) );
+                pxNewTCB = ( TCB_t * ) *ppucNextFree; /*lint !e9087 !e826 The block was allocated with enough space for the TCB and is suitably aligned. */
+                *ppucNextFree += taskBATCH_ALIGNED_SIZE( sizeof( TCB_t ) );
+            }
+            #endif /* portSTACK_GROWTH */
+
+            return pxNewTCB;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t xTaskCreateBatch( const TaskBatchParameters_t * const pxTaskDefinitions,
+                                     UBaseType_t uxNumberOfTasks )
+        {
+            uint8_t * pucBlock = NULL;
+            uint8_t * pucNextFree;
+            StackType_t * pxStack;
+            TCB_t * pxNewTCB;
+            size_t xBlockSize = 0;
+            size_t xTaskSize;
+            UBaseType_t x;
+            BaseType_t xReturn = pdPASS;
+
+            #if ( configNUMBER_OF_CORES == 1 )
+                TCB_t * pxHighestPriorityTCB = NULL;
+            #endif
+
+            traceENTER_xTaskCreateBatch( pxTaskDefinitions, uxNumberOfTasks );
+
+            configASSERT( pxTaskDefinitions != NULL );
+            configASSERT( uxNumberOfTasks > ( UBaseType_t ) 0U );
+
+            /* Size a single block that holds the TCB and stack of every task. */
+            for( x = ( UBaseType_t ) 0U; x < uxNumberOfTasks; x++ )
+            {
+                xTaskSize = taskBATCH_ALIGNED_SIZE( sizeof( TCB_t ) ) +
+                            taskBATCH_ALIGNED_SIZE( ( ( size_t ) pxTaskDefinitions[ x ].usStackDepth ) * sizeof( StackType_t ) );
+
+                if( ( xBlockSize + xTaskSize ) < xBlockSize )
+                {
+                    /* The total size does not fit in a size_t. */
+                    xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                    break;
+                }
+                else
+                {
+                    xBlockSize += xTaskSize;
+                }
+            }
+
+            if( xReturn == pdPASS )
+            {
+                pucBlock = ( uint8_t * ) pvPortMalloc( xBlockSize );
+
+                if( pucBlock == NULL )
+                {
+                    xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReturn == pdPASS )
+            {
+                /* Initialise every task outside of any critical section - this
+                 * touches only the new TCBs and stacks, which the scheduler
+                 * cannot see yet. */
+                pucNextFree = pucBlock;
+
+                for( x = ( UBaseType_t ) 0U; x < uxNumberOfTasks; x++ )
+                {
+                    pxNewTCB = prvCarveBatchTask( &pucNextFree, pxTaskDefinitions[ x ].usStackDepth, &pxStack );
+
+                    ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                    pxNewTCB->pxStack = pxStack;
+
+                    /* The TCB and stack are part of a shared block, so must not
+                     * be freed individually if the task is deleted. */
+                    pxNewTCB->ucStaticallyAllocated = tskBATCH_ALLOCATED_STACK_AND_TCB;
+
+                    prvInitialiseNewTask( pxTaskDefinitions[ x ].pxTaskCode,
+                                          pxTaskDefinitions[ x ].pcName,
+                                          ( uint32_t ) pxTaskDefinitions[ x ].usStackDepth,
+                                          pxTaskDefinitions[ x ].pvParameters,
+                                          pxTaskDefinitions[ x ].uxPriority,
+                                          pxTaskDefinitions[ x ].pxCreatedTask,
+                                          pxNewTCB,
+                                          NULL );
+
+                    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+                    {
+                        /* Set the task's affinity before scheduling it. */
+                        pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+                    }
+                    #endif
+                }
+
+                /* Make all the tasks known to the scheduler in one critical
+                 * section. */
+                pucNextFree = pucBlock;
+
+                taskENTER_CRITICAL();
+                {
+                    for( x = ( UBaseType_t ) 0U; x < uxNumberOfTasks; x++ )
+                    {
+                        pxNewTCB = prvCarveBatchTask( &pucNextFree, pxTaskDefinitions[ x ].usStackDepth, &pxStack );
+
+                        prvRegisterNewTask( pxNewTCB );
+
+                        #if ( configNUMBER_OF_CORES == 1 )
+                        {
+                            if( ( pxHighestPriorityTCB == NULL ) || ( pxNewTCB->uxPriority > pxHighestPriorityTCB->uxPriority ) )
+                            {
+                                pxHighestPriorityTCB = pxNewTCB;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                        {
+                            if( xSchedulerRunning != pdFALSE )
+                            {
+                                /* If the created task is of a higher priority
+                                 * than another currently running task and
+                                 * preemption is on then it should run now. */
+                                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( xSchedulerRunning != pdFALSE )
+                    {
+                        /* If the highest priority of the created tasks is
+                         * higher than the priority of the current task then
+                         * it should run now. */
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxHighestPriorityTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRETURN_xTaskCreateBatch( xReturn );
+
+            return xReturn;
+        }
+    #endif /* configUSE_TASK_BATCH_CREATION */
 
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
@@ -1961,6 +2856,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* portUSING_MPU_WRAPPERS */
 
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+    {
+        /* The initial context is the deepest the stack has been so far. */
+        pxNewTCB->pxStackHighWaterMark = ( StackType_t * ) pxNewTCB->pxTopOfStack;
+    }
+    #endif
+
     /* Initialize task state and task attributes. */
     #if ( configNUMBER_OF_CORES > 1 )
     {
@@ -1989,67 +2891,85 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 #if ( configNUMBER_OF_CORES == 1 )
 
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    static void prvRegisterNewTask( TCB_t * pxNewTCB )
     {
-        /* Ensure interrupts don't access the task lists while the lists are being
-         * updated. */
-        taskENTER_CRITICAL();
+        uxCurrentNumberOfTasks++;
+
+        if( pxCurrentTCB == NULL )
         {
-            uxCurrentNumberOfTasks++;
+            /* There are no other tasks, or all the other tasks are in
+             * the suspended state - make this the current task. */
+            pxCurrentTCB = pxNewTCB;
 
-            if( pxCurrentTCB == NULL )
+            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
             {
-                /* There are no other tasks, or all the other tasks are in
-                 * the suspended state - make this the current task. */
-                pxCurrentTCB = pxNewTCB;
-
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-                {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* This is the first task to be created so do the preliminary
+                 * initialisation required.  We will not recover if this call
+                 * fails, but we will report the failure. */
+                prvInitialiseTaskLists();
             }
             else
             {
-                /* If the scheduler is not already running, make this task the
-                 * current task if it is the highest priority task to be created
-                 * so far. */
-                if( xSchedulerRunning == pdFALSE )
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* If the scheduler is not already running, make this task the
+             * current task if it is the highest priority task to be created
+             * so far. */
+            if( xSchedulerRunning == pdFALSE )
+            {
+                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
                 {
-                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
-                    {
-                        pxCurrentTCB = pxNewTCB;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pxCurrentTCB = pxNewTCB;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-
-            uxTaskNumber++;
-
-            #if ( configUSE_TRACE_FACILITY == 1 )
+            else
             {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
+        }
+
+        uxTaskNumber++;
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            /* Add a counter into the TCB for tracing only. */
+            pxNewTCB->uxTCBNumber = uxTaskNumber;
+        }
+        #endif /* configUSE_TRACE_FACILITY */
+        traceTASK_CREATE( pxNewTCB );
+
+        #if ( configUSE_TASK_NAME_INDEX == 1 )
+        {
+            prvAddTaskToNameIndex( pxNewTCB );
+        }
+        #endif
 
-            prvAddTaskToReadyList( pxNewTCB );
+        prvAddTaskToReadyList( pxNewTCB );
 
-            portSETUP_TCB( pxNewTCB );
+        #if ( configUSE_TASK_SNAPSHOTS == 1 )
+        {
+            prvAllocateTaskSnapshot( pxNewTCB );
+        }
+        #endif
+
+        portSETUP_TCB( pxNewTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
+        {
+            prvRegisterNewTask( pxNewTCB );
         }
         taskEXIT_CRITICAL();
 
@@ -2067,66 +2987,84 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 #else /* #if ( configNUMBER_OF_CORES == 1 ) */
 
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    static void prvRegisterNewTask( TCB_t * pxNewTCB )
     {
-        /* Ensure interrupts don't access the task lists while the lists are being
-         * updated. */
-        taskENTER_CRITICAL();
+        uxCurrentNumberOfTasks++;
+
+        if( xSchedulerRunning == pdFALSE )
         {
-            uxCurrentNumberOfTasks++;
+            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            {
+                /* This is the first task to be created so do the preliminary
+                 * initialisation required.  We will not recover if this call
+                 * fails, but we will report the failure. */
+                prvInitialiseTaskLists();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-            if( xSchedulerRunning == pdFALSE )
+            if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
             {
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-                {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                BaseType_t xCoreID;
 
-                if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                /* Check if a core is free. */
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
                 {
-                    BaseType_t xCoreID;
-
-                    /* Check if a core is free. */
-                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    if( pxCurrentTCBs[ xCoreID ] == NULL )
                     {
-                        if( pxCurrentTCBs[ xCoreID ] == NULL )
-                        {
-                            pxNewTCB->xTaskRunState = xCoreID;
-                            pxCurrentTCBs[ xCoreID ] = pxNewTCB;
-                            break;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        pxNewTCB->xTaskRunState = xCoreID;
+                        pxCurrentTCBs[ xCoreID ] = pxNewTCB;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
             }
-
-            uxTaskNumber++;
-
-            #if ( configUSE_TRACE_FACILITY == 1 )
+            else
             {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
+        }
+
+        uxTaskNumber++;
+
+        #if ( configUSE_TRACE_FACILITY == 1 )
+        {
+            /* Add a counter into the TCB for tracing only. */
+            pxNewTCB->uxTCBNumber = uxTaskNumber;
+        }
+        #endif /* configUSE_TRACE_FACILITY */
+        traceTASK_CREATE( pxNewTCB );
+
+        #if ( configUSE_TASK_NAME_INDEX == 1 )
+        {
+            prvAddTaskToNameIndex( pxNewTCB );
+        }
+        #endif
+
+        prvAddTaskToReadyList( pxNewTCB );
+
+        #if ( configUSE_TASK_SNAPSHOTS == 1 )
+        {
+            prvAllocateTaskSnapshot( pxNewTCB );
+        }
+        #endif
 
-            prvAddTaskToReadyList( pxNewTCB );
+        portSETUP_TCB( pxNewTCB );
+    }
+/*-----------------------------------------------------------*/
 
-            portSETUP_TCB( pxNewTCB );
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
+        {
+            prvRegisterNewTask( pxNewTCB );
 
             if( xSchedulerRunning != pdFALSE )
             {
@@ -2213,6 +3151,19 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                if( pxTCB->xHasDeadline != pdFALSE )
+                {
+                    xDeadlineStats.uxNumberOfDeadlineTasks--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -2341,7 +3292,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         {
             /* Minor optimisation.  The tick count cannot change in this
              * block. */
-            const TickType_t xConstTickCount = xTickCount;
+            const TickType_t xConstTickCount = taskGET_TICK_COUNT_NOW();
 
             configASSERT( uxSchedulerSuspended == 1U );
 
@@ -2386,9 +3337,9 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
 
-                /* prvAddCurrentTaskToDelayedList() needs the block time, not
+                /* prvAddCurrentTaskToDelayedListFrom() needs the block time, not
                  * the time to wake, so subtract the current tick count. */
-                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+                prvAddCurrentTaskToDelayedListFrom( xConstTickCount, xTimeToWake - xConstTickCount, pdFALSE );
             }
             else
             {
@@ -2473,8 +3424,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         eTaskState eReturn;
         List_t const * pxStateList;
         List_t const * pxEventList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+        BaseType_t xStateListIsDelayedList;
         const TCB_t * const pxTCB = xTask;
 
         traceENTER_eTaskGetState( xTask );
@@ -2494,8 +3444,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
                 pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                xStateListIsDelayedList = taskLIST_IS_DELAYED_LIST( pxStateList );
             }
             taskEXIT_CRITICAL();
 
@@ -2506,7 +3455,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * item is currently placed on. */
                 eReturn = eReady;
             }
-            else if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            else if( xStateListIsDelayedList != pdFALSE )
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -2884,7 +3833,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * nothing more than change its priority variable. However, if
                  * the task is in a ready list it needs to be removed and placed
                  * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskGET_READY_LIST( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
                     /* The task is currently in its ready list - remove before
                      * adding it to its new ready list.  As we are in a critical
@@ -2954,206 +3903,589 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
-    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
-                               UBaseType_t uxCoreAffinityMask )
-    {
-        TCB_t * pxTCB;
-        BaseType_t xCoreID;
-        UBaseType_t uxPrevCoreAffinityMask;
-
-        #if ( configUSE_PREEMPTION == 1 )
-            UBaseType_t uxPrevNotAllowedCores;
-        #endif
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
 
-        traceENTER_vTaskCoreAffinitySet( xTask, uxCoreAffinityMask );
+    static List_t * prvGetReadyListForTask( const TCB_t * pxTCB,
+                                            UBaseType_t uxPriority )
+    {
+        List_t * pxReadyList = &( pxReadyTasksLists[ uxPriority ] );
+        const UBaseType_t uxCoreAffinityMask = pxTCB->uxCoreAffinityMask & ( ( ( UBaseType_t ) 1U << ( UBaseType_t ) configNUMBER_OF_CORES ) - 1U );
+        BaseType_t xCoreID = ( BaseType_t ) 0;
 
-        taskENTER_CRITICAL();
+        /* Only tasks that are allowed to run on exactly one core are held in
+         * that core's own ready lists. */
+        if( ( uxCoreAffinityMask != 0U ) && ( ( uxCoreAffinityMask & ( uxCoreAffinityMask - 1U ) ) == 0U ) )
         {
-            pxTCB = prvGetTCBFromHandle( xTask );
+            while( ( uxCoreAffinityMask >> ( UBaseType_t ) xCoreID ) != 1U )
+            {
+                xCoreID++;
+            }
 
-            uxPrevCoreAffinityMask = pxTCB->uxCoreAffinityMask;
-            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+            pxReadyList = &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( xSchedulerRunning != pdFALSE )
-            {
-                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                {
-                    xCoreID = ( BaseType_t ) pxTCB->xTaskRunState;
+        return pxReadyList;
+    }
+/*-----------------------------------------------------------*/
 
-                    /* If the task can no longer run on the core it was running,
-                     * request the core to yield. */
-                    if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
-                    {
-                        prvYieldCore( xCoreID );
-                    }
-                }
-                else
-                {
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Calculate the cores on which this task was not allowed to
-                         * run previously. */
-                        uxPrevNotAllowedCores = ( ~uxPrevCoreAffinityMask ) & ( ( 1U << configNUMBER_OF_CORES ) - 1U );
+    static UBaseType_t prvGetReadyTaskCount( UBaseType_t uxPriority )
+    {
+        UBaseType_t uxCount = listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) );
+        BaseType_t xCoreID;
 
-                        /* Does the new core mask enables this task to run on any of the
-                         * previously not allowed cores? If yes, check if this task can be
-                         * scheduled on any of those cores. */
-                        if( ( uxPrevNotAllowedCores & uxCoreAffinityMask ) != 0U )
-                        {
-                            prvYieldForTask( pxTCB );
-                        }
-                    }
-                    #else /* #if( configUSE_PREEMPTION == 1 ) */
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                    #endif /* #if( configUSE_PREEMPTION == 1 ) */
-                }
-            }
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            uxCount += listCURRENT_LIST_LENGTH( &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] ) );
         }
-        taskEXIT_CRITICAL();
 
-        traceRETURN_vTaskCoreAffinitySet();
+        return uxCount;
     }
-#endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+
+#endif /* configUSE_PER_CORE_READY_LISTS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
-    UBaseType_t vTaskCoreAffinityGet( ConstTaskHandle_t xTask )
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    static BaseType_t prvChargeCurrentTaskBudget( const TickType_t xConstTickCount )
     {
-        const TCB_t * pxTCB;
-        UBaseType_t uxCoreAffinityMask;
+        TCB_t * const pxTCB = pxCurrentTCB;
+        BaseType_t xSwitchRequired = pdFALSE;
+        TickType_t xTimeInPeriod;
 
-        traceENTER_vTaskCoreAffinityGet( xTask );
+        if( pxTCB->xBudget != ( TickType_t ) 0U )
+        {
+            xTimeInPeriod = xConstTickCount - pxTCB->xBudgetPeriodStart;
 
-        taskENTER_CRITICAL();
+            if( xTimeInPeriod >= pxTCB->xBudgetPeriod )
+            {
+                /* One or more periods have passed since the budget was last
+                 * replenished.  Keep the periods aligned to the time at which
+                 * the budget was set. */
+                xTimeInPeriod %= pxTCB->xBudgetPeriod;
+                pxTCB->xBudgetPeriodStart = xConstTickCount - xTimeInPeriod;
+                pxTCB->xBudgetRemaining = pxTCB->xBudget;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTCB->xBudgetRemaining > ( TickType_t ) 0U )
+            {
+                pxTCB->xBudgetRemaining--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The running task may already have left the Ready state if the
+             * context switch it requested has not yet occurred. */
+            if( ( pxTCB->xBudgetRemaining == ( TickType_t ) 0U ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                traceTASK_BUDGET_EXHAUSTED( pxTCB );
+
+                /* Block the task until the start of its next period.  The
+                 * wake time is relative to the tick being processed. */
+                prvAddCurrentTaskToDelayedListFrom( xConstTickCount, pxTCB->xBudgetPeriod - xTimeInPeriod, pdFALSE );
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
         {
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
-
-        traceRETURN_vTaskCoreAffinityGet( uxCoreAffinityMask );
 
-        return uxCoreAffinityMask;
+        return xSwitchRequired;
     }
-#endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
-
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
-
-    void vTaskPreemptionDisable( const TaskHandle_t xTask )
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         TickType_t xBudget,
+                         TickType_t xPeriod )
     {
         TCB_t * pxTCB;
 
-        traceENTER_vTaskPreemptionDisable( xTask );
+        traceENTER_vTaskSetBudget( xTask, xBudget, xPeriod );
+
+        configASSERT( ( xBudget == ( TickType_t ) 0U ) || ( xBudget <= xPeriod ) );
 
         taskENTER_CRITICAL();
         {
+            /* If null is passed in here then it is the budget of the calling
+             * task that is being set. */
             pxTCB = prvGetTCBFromHandle( xTask );
 
-            pxTCB->xPreemptionDisable = pdTRUE;
+            /* The idle task must always be able to run. */
+            configASSERT( ( xBudget == ( TickType_t ) 0U ) || ( pxTCB != xIdleTaskHandles[ 0 ] ) );
+
+            pxTCB->xBudget = xBudget;
+            pxTCB->xBudgetPeriod = xPeriod;
+            pxTCB->xBudgetRemaining = xBudget;
+            pxTCB->xBudgetPeriodStart = xTickCount;
         }
         taskEXIT_CRITICAL();
 
-        traceRETURN_vTaskPreemptionDisable();
+        traceRETURN_vTaskSetBudget();
     }
-
-#endif /* #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
-
-    void vTaskPreemptionEnable( const TaskHandle_t xTask )
+    TickType_t xTaskGetBudgetRemaining( const TaskHandle_t xTask )
     {
-        TCB_t * pxTCB;
-        BaseType_t xCoreID;
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
 
-        traceENTER_vTaskPreemptionEnable( xTask );
+        traceENTER_xTaskGetBudgetRemaining( xTask );
 
         taskENTER_CRITICAL();
         {
             pxTCB = prvGetTCBFromHandle( xTask );
 
-            pxTCB->xPreemptionDisable = pdFALSE;
-
-            if( xSchedulerRunning != pdFALSE )
+            if( pxTCB->xBudget == ( TickType_t ) 0U )
             {
-                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                {
-                    xCoreID = ( BaseType_t ) pxTCB->xTaskRunState;
-                    prvYieldCore( xCoreID );
-                }
+                xReturn = portMAX_DELAY;
+            }
+            else if( ( TickType_t ) ( xTickCount - pxTCB->xBudgetPeriodStart ) >= pxTCB->xBudgetPeriod )
+            {
+                /* The budget will be replenished the next time the task is
+                 * charged for a tick. */
+                xReturn = pxTCB->xBudget;
+            }
+            else
+            {
+                xReturn = pxTCB->xBudgetRemaining;
             }
         }
         taskEXIT_CRITICAL();
 
-        traceRETURN_vTaskPreemptionEnable();
+        traceRETURN_xTaskGetBudgetRemaining( xReturn );
+
+        return xReturn;
     }
 
-#endif /* #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    static BaseType_t prvTaskHasEarlierDeadline( const TCB_t * const pxTCB,
+                                                 const TCB_t * const pxOtherTCB )
     {
-        TCB_t * pxTCB;
-
-        #if ( configNUMBER_OF_CORES > 1 )
-            BaseType_t xTaskRunningOnCore;
-        #endif
-
-        traceENTER_vTaskSuspend( xTaskToSuspend );
+        BaseType_t xReturn;
 
-        taskENTER_CRITICAL();
+        if( pxTCB->xHasDeadline == pdFALSE )
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+            /* Tasks without a deadline are treated as already due, but do not
+             * overtake each other. */
+            xReturn = ( pxOtherTCB->xHasDeadline != pdFALSE ) ? pdTRUE : pdFALSE;
+        }
+        else if( pxOtherTCB->xHasDeadline == pdFALSE )
+        {
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            xReturn = taskDEADLINE_IS_BEFORE( pxTCB->xDeadline, pxOtherTCB->xDeadline ) ? pdTRUE : pdFALSE;
+        }
 
-            traceTASK_SUSPEND( pxTCB );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-            #if ( configNUMBER_OF_CORES > 1 )
-                xTaskRunningOnCore = pxTCB->xTaskRunState;
-            #endif
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB )
+    {
+        List_t * const pxReadyList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+        ListItem_t * pxIterator;
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+        /* Find the first task that should run after pxTCB.  Tasks with equal
+         * deadlines are kept in the order in which they became ready. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( prvTaskHasEarlierDeadline( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                break;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+        }
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+        /* listINSERT_END() inserts in front of the list's index.  The index
+         * of this list is not otherwise used as tasks are always taken from
+         * its head, so point it at the insertion point for the duration of
+         * the insert. */
+        pxReadyList->pxIndex = pxIterator;
+        listINSERT_END( pxReadyList, &( pxTCB->xStateListItem ) );
+        pxReadyList->pxIndex = ( ListItem_t * ) &( pxReadyList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetTaskDeadline( TCB_t * const pxTCB,
+                                    TickType_t xRelativeDeadline )
+    {
+        const TickType_t xConstTickCount = xTickCount;
+
+        if( pxTCB->xHasDeadline != pdFALSE )
+        {
+            if( taskDEADLINE_IS_BEFORE( pxTCB->xDeadline, xConstTickCount ) )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                xDeadlineStats.uxDeadlinesMissed++;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xDeadlineStats.uxDeadlinesMet++;
             }
+        }
+        else
+        {
+            pxTCB->xHasDeadline = pdTRUE;
+            xDeadlineStats.uxNumberOfDeadlineTasks++;
+        }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+        pxTCB->xDeadline = xConstTickCount + xRelativeDeadline;
+    }
+/*-----------------------------------------------------------*/
 
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    void vTaskSetDeadline( TaskHandle_t xTask,
+                           TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        traceENTER_vTaskSetDeadline( xTask, xRelativeDeadline );
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            prvSetTaskDeadline( pxTCB, xRelativeDeadline );
+
+            /* If the task is in the deadline ordered ready list then it must
+             * be moved to the position of its new deadline. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
             {
-                BaseType_t x;
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                prvInsertTaskByDeadline( pxTCB );
 
-                for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                if( xSchedulerRunning != pdFALSE )
                 {
-                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    if( pxTCB == pxCurrentTCB )
                     {
-                        /* The task was blocked to wait for a notification, but is
-                         * now suspended, so no notification was received. */
-                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                        /* The running task's new deadline may be later than
+                         * that of another ready task. */
+                        if( listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ) != pxCurrentTCB )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxCurrentTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetDeadline();
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetDeadline( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xReturn;
+
+        traceENTER_xTaskGetDeadline( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = ( pxTCB->xHasDeadline != pdFALSE ) ? pxTCB->xDeadline : portMAX_DELAY;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xTaskGetDeadline( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetDeadlineStats( TaskDeadlineStats_t * pxDeadlineStats )
+    {
+        traceENTER_vTaskGetDeadlineStats( pxDeadlineStats );
+
+        configASSERT( pxDeadlineStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxDeadlineStats = xDeadlineStats;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskGetDeadlineStats();
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+        UBaseType_t uxPrevCoreAffinityMask;
+
+        #if ( configUSE_PREEMPTION == 1 )
+            UBaseType_t uxPrevNotAllowedCores;
+        #endif
+
+        traceENTER_vTaskCoreAffinitySet( xTask, uxCoreAffinityMask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            uxPrevCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+
+            #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            {
+                /* The ready list a task is held in depends on its affinity, so
+                 * a ready task must be moved to the list for its new mask. */
+                if( listIS_CONTAINED_WITHIN( prvGetReadyListForTask( pxTCB, pxTCB->uxPriority ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+                }
+            }
+            #else
+            {
+                pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+            }
+            #endif
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                {
+                    xCoreID = ( BaseType_t ) pxTCB->xTaskRunState;
+
+                    /* If the task can no longer run on the core it was running,
+                     * request the core to yield. */
+                    if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
+                    {
+                        prvYieldCore( xCoreID );
+                    }
+                }
+                else
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Calculate the cores on which this task was not allowed to
+                         * run previously. */
+                        uxPrevNotAllowedCores = ( ~uxPrevCoreAffinityMask ) & ( ( 1U << configNUMBER_OF_CORES ) - 1U );
+
+                        /* Does the new core mask enables this task to run on any of the
+                         * previously not allowed cores? If yes, check if this task can be
+                         * scheduled on any of those cores. */
+                        if( ( uxPrevNotAllowedCores & uxCoreAffinityMask ) != 0U )
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                    }
+                    #else /* #if( configUSE_PREEMPTION == 1 ) */
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                    #endif /* #if( configUSE_PREEMPTION == 1 ) */
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskCoreAffinitySet();
+    }
+#endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    UBaseType_t vTaskCoreAffinityGet( ConstTaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        traceENTER_vTaskCoreAffinityGet( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskCoreAffinityGet( uxCoreAffinityMask );
+
+        return uxCoreAffinityMask;
+    }
+#endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+
+    void vTaskPreemptionDisable( const TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        traceENTER_vTaskPreemptionDisable( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->xPreemptionDisable = pdTRUE;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskPreemptionDisable();
+    }
+
+#endif /* #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+
+    void vTaskPreemptionEnable( const TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+
+        traceENTER_vTaskPreemptionEnable( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->xPreemptionDisable = pdFALSE;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                {
+                    xCoreID = ( BaseType_t ) pxTCB->xTaskRunState;
+                    prvYieldCore( xCoreID );
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskPreemptionEnable();
+    }
+
+#endif /* #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    {
+        TCB_t * pxTCB;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xTaskRunningOnCore;
+        #endif
+
+        traceENTER_vTaskSuspend( xTaskToSuspend );
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+            traceTASK_SUSPEND( pxTCB );
+
+            #if ( configNUMBER_OF_CORES > 1 )
+                xTaskRunningOnCore = pxTCB->xTaskRunState;
+            #endif
+
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            {
+                BaseType_t x;
+
+                for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                {
+                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    {
+                        /* The task was blocked to wait for a notification, but is
+                         * now suspended, so no notification was received. */
+                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
                     }
                 }
             }
@@ -3414,7 +4746,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         /* Ready lists can be accessed so move the task from the
                          * suspended list to the ready list directly. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             xYieldRequired = pdTRUE;
 
@@ -3647,6 +4979,14 @@ void vTaskStartScheduler( void )
          * starts to run. */
         portDISABLE_INTERRUPTS();
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Load the core-local copy of the running task for this core.  The
+             * port loads it for the other cores as it starts them. */
+            portSET_CURRENT_TCB( pxCurrentTCBs[ portGET_CORE_ID() ] );
+        }
+        #endif
+
         #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         {
             /* Switch C-Runtime's TLS Block to point to the TLS
@@ -3811,13 +5151,22 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_TASK_SELECTION_BITMAP == 0 ) )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        {
+            /* Any bit other than the idle priority bit means a task above the
+             * idle priority is in the Ready state. */
+            if( ( ulReadyPriorityGroups > ( uint32_t ) 1U ) || ( ulReadyPriorityBitmap[ 0 ] > ( uint32_t ) 1U ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
         #else
         {
             const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
@@ -3855,6 +5204,21 @@ void vTaskSuspendAll( void )
         else
         {
             xReturn = xNextTaskUnblockTime - xTickCount;
+
+            #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+            {
+                /* The run time counter must be read before its low 32 bits
+                 * wrap, so do not sleep for longer than that allows. */
+                if( xReturn > taskRUN_TIME_COUNTER_MAX_SUPPRESSED_TICKS )
+                {
+                    xReturn = taskRUN_TIME_COUNTER_MAX_SUPPRESSED_TICKS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_64_BIT_RUN_TIME_COUNTER */
         }
 
         return xReturn;
@@ -3909,7 +5273,7 @@ BaseType_t xTaskResumeAll( void )
                         {
                             /* If the moved task has a priority higher than the current
                              * task then a yield must be performed. */
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xYieldPendings[ xCoreID ] = pdTRUE;
                             }
@@ -3952,9 +5316,16 @@ BaseType_t xTaskResumeAll( void )
 
                         if( xPendedCounts > ( TickType_t ) 0U )
                         {
-                            do
+                            /* The ticks are counted down in xPendedCounts, so
+                             * clear xPendedTicks first.  Otherwise the current
+                             * tick count would include ticks that are still to
+                             * be processed while the delayed tasks are
+                             * unblocked. */
+                            xPendedTicks = 0;
+
+                            #if ( configUSE_FAST_TICK_CATCH_UP == 1 )
                             {
-                                if( xTaskIncrementTick() != pdFALSE )
+                                if( prvCatchUpPendedTicks( xPendedCounts ) != pdFALSE )
                                 {
                                     /* Other cores are interrupted from
                                      * within xTaskIncrementTick(). */
@@ -3964,11 +5335,26 @@ BaseType_t xTaskResumeAll( void )
                                 {
                                     mtCOVERAGE_TEST_MARKER();
                                 }
-
-                                --xPendedCounts;
-                            } while( xPendedCounts > ( TickType_t ) 0U );
-
-                            xPendedTicks = 0;
+                            }
+                            #else /* if ( configUSE_FAST_TICK_CATCH_UP == 1 ) */
+                            {
+                                do
+                                {
+                                    if( xTaskIncrementTick() != pdFALSE )
+                                    {
+                                        /* Other cores are interrupted from
+                                         * within xTaskIncrementTick(). */
+                                        xYieldPendings[ xCoreID ] = pdTRUE;
+                                    }
+                                    else
+                                    {
+                                        mtCOVERAGE_TEST_MARKER();
+                                    }
+
+                                    --xPendedCounts;
+                                } while( xPendedCounts > ( TickType_t ) 0U );
+                            }
+                            #endif /* if ( configUSE_FAST_TICK_CATCH_UP == 1 ) */
                         }
                         else
                         {
@@ -4016,12 +5402,20 @@ TickType_t xTaskGetTickCount( void )
 
     traceENTER_xTaskGetTickCount();
 
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
+    #if ( configUSE_DYNAMIC_TICK == 1 )
     {
-        xTicks = xTickCount;
+        xTicks = prvGetTickCountNow();
     }
-    portTICK_TYPE_EXIT_CRITICAL();
+    #else
+    {
+        /* Critical section required if running on a 16 bit processor. */
+        portTICK_TYPE_ENTER_CRITICAL();
+        {
+            xTicks = xTickCount;
+        }
+        portTICK_TYPE_EXIT_CRITICAL();
+    }
+    #endif /* if ( configUSE_DYNAMIC_TICK == 1 ) */
 
     traceRETURN_xTaskGetTickCount( xTicks );
 
@@ -4052,11 +5446,23 @@ TickType_t xTaskGetTickCountFromISR( void )
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    #if ( configUSE_DYNAMIC_TICK == 1 )
     {
-        xReturn = xTickCount;
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            xReturn = xTickCount + xPendedTicks + ( TickType_t ) portGET_UNANNOUNCED_TICKS();
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    #else
+    {
+        uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = xTickCount;
+        }
+        portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* if ( configUSE_DYNAMIC_TICK == 1 ) */
 
     traceRETURN_xTaskGetTickCountFromISR( xReturn );
 
@@ -4093,7 +5499,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 0 )
 
     #if ( configNUMBER_OF_CORES == 1 )
         static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
@@ -4218,84 +5624,217 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                     }
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            return pxReturn;
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+#endif /* ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 0 )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        traceENTER_xTaskGetHandle( pcNameToQuery );
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            {
+                BaseType_t xCoreID;
+
+                for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( pxTCB == NULL ); xCoreID++ )
+                {
+                    for( uxQueue = ( UBaseType_t ) 0U; ( uxQueue < ( UBaseType_t ) configMAX_PRIORITIES ) && ( pxTCB == NULL ); uxQueue++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( pxCoreReadyTasksLists[ xCoreID ][ uxQueue ] ), pcNameToQuery );
+                    }
+                }
+            }
+            #endif /* configUSE_PER_CORE_READY_LISTS */
+
+            /* Search the delayed lists. */
+            #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+            {
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+            {
+                UBaseType_t uxLevel, uxBucket;
+
+                for( uxLevel = 0U; ( uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+                {
+                    for( uxBucket = 0U; ( uxBucket < taskWHEEL_BUCKETS_PER_LEVEL ) && ( pxTCB == NULL ); uxBucket++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxLevel ][ uxBucket ] ), pcNameToQuery );
+                    }
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &xDelayedTaskWheelOverflow, pcNameToQuery );
+                }
+            }
+            #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the suspended list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the deleted list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                }
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_xTaskGetHandle( pxTCB );
+
+        return pxTCB;
+    }
+
+#endif /* ( INCLUDE_xTaskGetHandle == 1 ) && ( configUSE_TASK_NAME_INDEX == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NAME_INDEX == 1 )
+
+    static UBaseType_t prvTaskNameIndexBucket( const char pcName[] )
+    {
+        uint32_t ulHash = 2166136261UL;
+        UBaseType_t x;
+
+        /* FNV-1a hash of the name, which is at most configMAX_TASK_NAME_LEN
+         * characters including the terminator. */
+        for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ x ] != ( char ) 0x00 ); x++ )
+        {
+            ulHash ^= ( uint32_t ) ( ( uint8_t ) pcName[ x ] );
+            ulHash *= 16777619UL;
+        }
+
+        return ( UBaseType_t ) ( ulHash % ( uint32_t ) configTASK_NAME_INDEX_SIZE );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddTaskToNameIndex( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxBucket = prvTaskNameIndexBucket( pxTCB->pcTaskName );
+
+        /* Called from within a critical section. */
+        pxTCB->pxNextInNameIndex = pxTaskNameIndex[ uxBucket ];
+        pxTaskNameIndex[ uxBucket ] = pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+
+        static void prvRemoveTaskFromNameIndex( const TCB_t * pxTCB )
+        {
+            const UBaseType_t uxBucket = prvTaskNameIndexBucket( pxTCB->pcTaskName );
+            TCB_t ** ppxLink;
+
+            taskENTER_CRITICAL();
+            {
+                for( ppxLink = &( pxTaskNameIndex[ uxBucket ] ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextInNameIndex ) )
+                {
+                    if( *ppxLink == pxTCB )
+                    {
+                        *ppxLink = pxTCB->pxNextInNameIndex;
+                        break;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
         }
-    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
-#endif /* INCLUDE_xTaskGetHandle */
+    #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
         TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+        UBaseType_t x;
 
         traceENTER_xTaskGetHandle( pcNameToQuery );
 
         /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
         configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
 
-        vTaskSuspendAll();
-        {
-            /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
-
-                if( pxTCB != NULL )
-                {
-                    /* Found the handle. */
-                    break;
-                }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
-            {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
-
-            if( pxTCB == NULL )
-            {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
-            }
+        uxBucket = prvTaskNameIndexBucket( pcNameToQuery );
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
+        /* Only tasks whose names share a bucket with pcNameToQuery need to be
+         * checked.  The index is only updated from within critical sections, so
+         * a critical section is used in place of suspending the scheduler. */
+        taskENTER_CRITICAL();
+        {
+            for( pxTCB = pxTaskNameIndex[ uxBucket ]; pxTCB != NULL; pxTCB = pxTCB->pxNextInNameIndex )
             {
-                if( pxTCB == NULL )
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
                 {
-                    /* Search the suspended list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                    if( ( pxTCB->pcTaskName[ x ] != pcNameToQuery[ x ] ) || ( pcNameToQuery[ x ] == ( char ) 0x00 ) )
+                    {
+                        break;
+                    }
                 }
-            }
-            #endif
 
-            #if ( INCLUDE_vTaskDelete == 1 )
-            {
-                if( pxTCB == NULL )
+                if( ( x < ( UBaseType_t ) configMAX_TASK_NAME_LEN ) && ( pxTCB->pcTaskName[ x ] == pcNameToQuery[ x ] ) )
                 {
-                    /* Search the deleted list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                    /* Both strings terminated, a match has been found. */
+                    break;
                 }
             }
-            #endif
         }
-        ( void ) xTaskResumeAll();
+        taskEXIT_CRITICAL();
 
         traceRETURN_xTaskGetHandle( pxTCB );
 
         return pxTCB;
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* configUSE_TASK_NAME_INDEX */
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -4372,61 +5911,339 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                     uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady ) );
                 } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Blocked state. */
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked ) );
+                #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+                {
+                    BaseType_t xCoreID;
+
+                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configMAX_PRIORITIES; uxQueue++ )
+                        {
+                            uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxCoreReadyTasksLists[ xCoreID ][ uxQueue ] ), eReady ) );
+                        }
+                    }
+                }
+                #endif /* configUSE_PER_CORE_READY_LISTS */
+
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Blocked state. */
+                #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked ) );
+                }
+                #else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+                {
+                    UBaseType_t uxLevel, uxBucket;
+
+                    for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxBucket = 0U; uxBucket < taskWHEEL_BUCKETS_PER_LEVEL; uxBucket++ )
+                        {
+                            uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxLevel ][ uxBucket ] ), eBlocked ) );
+                        }
+                    }
+
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xDelayedTaskWheelOverflow, eBlocked ) );
+                }
+                #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task that has been deleted but not yet cleaned up. */
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted ) );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task in the Suspended state. */
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended ) );
+                }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+                            taskENTER_CRITICAL();
+                            {
+                                *pulTotalRunTime = prvGetRunTimeCounterValue();
+                            }
+                            taskEXIT_CRITICAL();
+                        #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
+                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                        #else
+                            *pulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+                        #endif
+                    }
+                }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        *pulTotalRunTime = 0;
+                    }
+                }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_uxTaskGetSystemState( uxTask );
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+    static void prvAllocateTaskSnapshot( TCB_t * pxTCB )
+    {
+        UBaseType_t x;
+
+        pxTCB->uxSnapshotIndex = taskSNAPSHOT_INDEX_NONE;
+
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_SNAPSHOT_TABLE_SIZE; x++ )
+        {
+            if( xTaskSnapshots[ x ].xSnapshot.xHandle == NULL )
+            {
+                pxTCB->uxSnapshotIndex = x;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        prvPublishTaskSnapshot( pxTCB, eReady );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+
+        static void prvReleaseTaskSnapshot( const TCB_t * pxTCB )
+        {
+            volatile TaskSnapshotEntry_t * pxEntry;
+
+            if( pxTCB->uxSnapshotIndex != taskSNAPSHOT_INDEX_NONE )
+            {
+                pxEntry = &( xTaskSnapshots[ pxTCB->uxSnapshotIndex ] );
+
+                taskENTER_CRITICAL();
+                {
+                    pxEntry->ulSequence++;
+                    portMEMORY_BARRIER();
+                    pxEntry->xSnapshot.xHandle = NULL;
+                    portMEMORY_BARRIER();
+                    pxEntry->ulSequence++;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+    static void prvPublishTaskSnapshot( const TCB_t * pxTCB,
+                                        eTaskState eState )
+    {
+        volatile TaskSnapshotEntry_t * pxEntry;
+        const StackType_t * pxDeepestStack;
+        configSTACK_DEPTH_TYPE uxStackSpace;
+
+        if( pxTCB->uxSnapshotIndex != taskSNAPSHOT_INDEX_NONE )
+        {
+            pxEntry = &( xTaskSnapshots[ pxTCB->uxSnapshotIndex ] );
+
+            #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+            {
+                pxDeepestStack = pxTCB->pxStackHighWaterMark;
+            }
+            #else
+            {
+                pxDeepestStack = ( const StackType_t * ) pxTCB->pxTopOfStack;
+            }
+            #endif
+
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                uxStackSpace = ( configSTACK_DEPTH_TYPE ) ( pxDeepestStack - pxTCB->pxStack );
+            }
+            #else
+            {
+                uxStackSpace = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxDeepestStack );
+            }
+            #endif
+
+            /* Make the sequence number odd while the entry is inconsistent. */
+            pxEntry->ulSequence++;
+            portMEMORY_BARRIER();
+
+            if( pxEntry->xSnapshot.xHandle != ( TaskHandle_t ) pxTCB )
+            {
+                /* The entry has only just been claimed by this task. */
+                pxEntry->xSnapshot.xHandle = ( TaskHandle_t ) pxTCB;
+                pxEntry->xSnapshot.usStackHighWaterMark = uxStackSpace;
+            }
+            else if( uxStackSpace < pxEntry->xSnapshot.usStackHighWaterMark )
+            {
+                pxEntry->xSnapshot.usStackHighWaterMark = uxStackSpace;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxEntry->xSnapshot.eCurrentState = eState;
+            pxEntry->xSnapshot.uxCurrentPriority = pxTCB->uxPriority;
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                pxEntry->xSnapshot.uxBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                pxEntry->xSnapshot.uxBasePriority = pxTCB->uxPriority;
+            }
+            #endif
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxEntry->xSnapshot.ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+            }
+            #else
+            {
+                pxEntry->xSnapshot.ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            }
+            #endif
+
+            portMEMORY_BARRIER();
+            pxEntry->ulSequence++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static eTaskState prvGetSnapshotTaskState( const TCB_t * pxTCB )
+    {
+        eTaskState eReturn;
+        const List_t * const pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+        const List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        /* See eTaskGetState() for the reasoning behind each test. */
+        if( pxEventList == &xPendingReadyList )
+        {
+            eReturn = eReady;
+        }
+        else if( taskLIST_IS_DELAYED_LIST( pxStateList ) != pdFALSE )
+        {
+            eReturn = eBlocked;
+        }
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( pxStateList == &xSuspendedTaskList )
+            {
+                eReturn = ( pxEventList == NULL ) ? eSuspended : eBlocked;
+
+                #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                {
+                    BaseType_t x;
+
+                    for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                    {
+                        if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                        {
+                            eReturn = eBlocked;
+                            break;
+                        }
+                    }
+                }
+                #endif /* configUSE_TASK_NOTIFICATIONS */
+            }
+        #endif /* INCLUDE_vTaskSuspend */
+
+        #if ( INCLUDE_vTaskDelete == 1 )
+            else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+            {
+                eReturn = eDeleted;
+            }
+        #endif
+
+        else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+        {
+            eReturn = eReady;
+        }
+
+        return eReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetSnapshot( TaskSnapshot_t * const pxSnapshotArray,
+                                   const UBaseType_t uxArraySize )
+    {
+        UBaseType_t x;
+        UBaseType_t uxTask = 0;
+        uint32_t ulSequence;
+        TaskSnapshot_t xSnapshot;
+
+        traceENTER_uxTaskGetSnapshot( pxSnapshotArray, uxArraySize );
 
-                #if ( INCLUDE_vTaskDelete == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task that has been deleted but not yet cleaned up. */
-                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted ) );
-                }
-                #endif
+        configASSERT( ( pxSnapshotArray != NULL ) || ( uxArraySize == ( UBaseType_t ) 0 ) );
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+        for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) configTASK_SNAPSHOT_TABLE_SIZE ) && ( uxTask < uxArraySize ); x++ )
+        {
+            /* Copy the entry, then retry if it was updated during the copy.
+             * The writer cannot be preempted by a task, so on a single core
+             * the sequence number is only ever seen to be odd if the entry is
+             * being written by another core. */
+            do
+            {
+                do
                 {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task in the Suspended state. */
-                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended ) );
-                }
-                #endif
+                    ulSequence = xTaskSnapshots[ x ].ulSequence;
+                } while( ( ulSequence & 1U ) != 0U );
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
-                {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                        #else
-                            *pulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
-                        #endif
-                    }
-                }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
-                {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        *pulTotalRunTime = 0;
-                    }
-                }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                portMEMORY_BARRIER();
+                xSnapshot = xTaskSnapshots[ x ].xSnapshot;
+                portMEMORY_BARRIER();
+            } while( ulSequence != xTaskSnapshots[ x ].ulSequence );
+
+            if( xSnapshot.xHandle != NULL )
+            {
+                pxSnapshotArray[ uxTask ] = xSnapshot;
+                uxTask++;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
 
-        traceRETURN_uxTaskGetSystemState( uxTask );
+        traceRETURN_uxTaskGetSnapshot( uxTask );
 
         return uxTask;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* configUSE_TASK_SNAPSHOTS */
+/*-----------------------------------------------------------*/
 
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
@@ -4519,123 +6336,397 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
     traceENTER_xTaskCatchUpTicks( xTicksToCatchUp );
 
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == ( UBaseType_t ) 0U );
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == ( UBaseType_t ) 0U );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+
+    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+    taskENTER_CRITICAL();
+    {
+        xPendedTicks += xTicksToCatchUp;
+    }
+    taskEXIT_CRITICAL();
+    xYieldOccurred = xTaskResumeAll();
+
+    traceRETURN_xTaskCatchUpTicks( xYieldOccurred );
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskAbortDelay( xTask );
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state. */
+            if( eTaskGetState( xTask ) == eBlocked )
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPendings[ 0 ] = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        traceRETURN_xTaskAbortDelay( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+#if ( ( configUSE_FAST_TICK_CATCH_UP == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
+
+    static BaseType_t prvCatchUpPendedTicks( TickType_t xTicksToCatchUp )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+        TickType_t xTicksToSkip;
+
+        while( xTicksToCatchUp > ( TickType_t ) 0U )
+        {
+            /* Nothing needs to be done on the ticks before the next task
+             * unblock time (which, when the timing wheel is used, includes the
+             * ticks at which a bucket is cascaded), or before the tick count
+             * overflows, so those ticks can be skipped.  The last pended tick
+             * is always processed by xTaskIncrementTick() so time slicing is
+             * evaluated as normal. */
+            xTicksToSkip = xTicksToCatchUp - ( TickType_t ) 1U;
+
+            if( xNextTaskUnblockTime > xTickCount )
+            {
+                if( ( xNextTaskUnblockTime - xTickCount - ( TickType_t ) 1U ) < xTicksToSkip )
+                {
+                    xTicksToSkip = xNextTaskUnblockTime - xTickCount - ( TickType_t ) 1U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xTicksToSkip = 0U;
+            }
+
+            if( ( portMAX_DELAY - xTickCount ) < xTicksToSkip )
+            {
+                xTicksToSkip = portMAX_DELAY - xTickCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_TASK_BUDGETS == 1 )
+            {
+                TCB_t * const pxTCB = pxCurrentTCB;
+                TickType_t xTimeInPeriod;
+
+                /* The running task is charged for each skipped tick.  Stop
+                 * short of the tick at which its budget would be used up or
+                 * its next period would start so those ticks are handled by
+                 * prvChargeCurrentTaskBudget(). */
+                if( ( pxTCB->xBudget != ( TickType_t ) 0U ) && ( xTicksToSkip > ( TickType_t ) 0U ) )
+                {
+                    xTimeInPeriod = xTickCount - pxTCB->xBudgetPeriodStart;
+
+                    if( xTimeInPeriod >= ( pxTCB->xBudgetPeriod - ( TickType_t ) 1U ) )
+                    {
+                        xTicksToSkip = 0U;
+                    }
+                    else if( ( pxTCB->xBudgetPeriod - xTimeInPeriod - ( TickType_t ) 1U ) < xTicksToSkip )
+                    {
+                        xTicksToSkip = pxTCB->xBudgetPeriod - xTimeInPeriod - ( TickType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxTCB->xBudgetRemaining > ( TickType_t ) 0U )
+                    {
+                        if( ( pxTCB->xBudgetRemaining - ( TickType_t ) 1U ) < xTicksToSkip )
+                        {
+                            xTicksToSkip = pxTCB->xBudgetRemaining - ( TickType_t ) 1U;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxTCB->xBudgetRemaining -= xTicksToSkip;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TASK_BUDGETS */
+
+            xTickCount += xTicksToSkip;
+            xTicksToCatchUp -= xTicksToSkip;
+
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            --xTicksToCatchUp;
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* #if ( ( configUSE_FAST_TICK_CATCH_UP == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    BaseType_t xTaskAnnounceTicks( TickType_t xTicksElapsed )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        traceENTER_xTaskAnnounceTicks( xTicksElapsed );
+
+        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+        {
+            /* xTaskIncrementTick() is not called if the scheduler is suspended,
+             * so read the run time counter here too.  The number of ticks
+             * between calls is limited by configRUN_TIME_COUNTER_WRAP_TICKS. */
+            ( void ) prvGetRunTimeCounterValue();
+        }
+        #endif
+
+        if( xTicksElapsed > ( TickType_t ) 0U )
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+            {
+                xSwitchRequired = prvCatchUpPendedTicks( xTicksElapsed );
+            }
+            else
+            {
+                /* The ticks are processed when the scheduler is resumed. */
+                xPendedTicks += xTicksElapsed;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvSetNextTickInterrupt();
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
+        traceRETURN_xTaskAnnounceTicks( xSwitchRequired );
 
-    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-    taskENTER_CRITICAL();
-    {
-        xPendedTicks += xTicksToCatchUp;
+        return xSwitchRequired;
     }
-    taskEXIT_CRITICAL();
-    xYieldOccurred = xTaskResumeAll();
-
-    traceRETURN_xTaskCatchUpTicks( xYieldOccurred );
-
-    return xYieldOccurred;
-}
-/*----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+/*-----------------------------------------------------------*/
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    static void prvSetNextTickInterrupt( void )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
+        /* The tick count the port has already announced to the kernel.  The
+         * requested number of ticks is relative to this count. */
+        const TickType_t xAnnouncedTickCount = xTickCount + xPendedTicks;
+        TickType_t xExpectedTicks = portMAX_DELAY;
 
-        traceENTER_xTaskAbortDelay( xTask );
+        if( xNextTaskUnblockTime > xAnnouncedTickCount )
+        {
+            xExpectedTicks = xNextTaskUnblockTime - xAnnouncedTickCount;
+        }
+        else
+        {
+            xExpectedTicks = ( TickType_t ) 1U;
+        }
 
-        configASSERT( pxTCB );
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            /* The tick hook is called on every tick. */
+            xExpectedTicks = ( TickType_t ) 1U;
+        }
+        #endif
 
-        vTaskSuspendAll();
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+            /* The running task is time sliced with other ready tasks of the same
+             * priority. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
             {
-                xReturn = pdPASS;
+                #if ( configUSE_EDF_SCHEDULING == 1 )
+                    if( !taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) )
+                #endif
+                {
+                    xExpectedTicks = ( TickType_t ) 1U;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+        #if ( configUSE_TASK_BUDGETS == 1 )
+        {
+            const TCB_t * const pxTCB = pxCurrentTCB;
+            TickType_t xTicksToPeriodEnd;
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
+            if( pxTCB->xBudget != ( TickType_t ) 0U )
+            {
+                /* The budget is charged, and replenished, a tick at a time. */
+                if( ( pxTCB->xBudgetRemaining > ( TickType_t ) 0U ) && ( pxTCB->xBudgetRemaining < xExpectedTicks ) )
                 {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    xExpectedTicks = pxTCB->xBudgetRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                taskEXIT_CRITICAL();
 
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
+                xTicksToPeriodEnd = pxTCB->xBudgetPeriod - ( xAnnouncedTickCount - pxTCB->xBudgetPeriodStart );
 
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                if( ( xTicksToPeriodEnd > pxTCB->xBudgetPeriod ) || ( xTicksToPeriodEnd == ( TickType_t ) 0U ) )
                 {
-                    #if ( configNUMBER_OF_CORES == 1 )
-                    {
-                        /* Preemption is on, but a context switch should only be
-                         * performed if the unblocked task has a priority that is
-                         * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            /* Pend the yield to be performed when the scheduler
-                             * is unsuspended. */
-                            xYieldPendings[ 0 ] = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            prvYieldForTask( pxTCB );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
-                    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+                    /* The period has already ended. */
+                    xExpectedTicks = ( TickType_t ) 1U;
+                }
+                else if( xTicksToPeriodEnd < xExpectedTicks )
+                {
+                    xExpectedTicks = xTicksToPeriodEnd;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* #if ( configUSE_PREEMPTION == 1 ) */
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
+        #endif /* configUSE_TASK_BUDGETS */
 
-        traceRETURN_xTaskAbortDelay( xReturn );
+        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+        {
+            /* The run time counter must be read before its low 32 bits wrap. */
+            if( xExpectedTicks > taskRUN_TIME_COUNTER_MAX_SUPPRESSED_TICKS )
+            {
+                xExpectedTicks = taskRUN_TIME_COUNTER_MAX_SUPPRESSED_TICKS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_64_BIT_RUN_TIME_COUNTER */
 
-        return xReturn;
+        xNextTickInterrupt = xAnnouncedTickCount + xExpectedTicks;
+        portSET_NEXT_TICK_INTERRUPT( xExpectedTicks );
     }
+/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
+    static TickType_t prvGetTickCountNow( void )
+    {
+        TickType_t xTicks;
+
+        taskENTER_CRITICAL();
+        {
+            xTicks = xTickCount + xPendedTicks + ( TickType_t ) portGET_UNANNOUNCED_TICKS();
+        }
+        taskEXIT_CRITICAL();
+
+        return xTicks;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*-----------------------------------------------------------*/
 
 BaseType_t xTaskIncrementTick( void )
 {
@@ -4654,6 +6745,16 @@ BaseType_t xTaskIncrementTick( void )
      * tasks to be unblocked. */
     traceTASK_INCREMENT_TICK( xTickCount );
 
+    #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+    {
+        /* Read the run time counter at least once per tick so a wrap of its
+         * low 32 bits is never missed, even if no context switch occurs.  On
+         * SMP the tick is only processed by one core, which is enough as the
+         * extended value is shared by all cores. */
+        ( void ) prvGetRunTimeCounterValue();
+    }
+    #endif
+
     /* Tick increment should occur on every kernel timer event. Core 0 has the
      * responsibility to increment the tick, or increment the pended ticks if the
      * scheduler is suspended.  If pended ticks is greater than zero, the core that
@@ -4668,6 +6769,22 @@ BaseType_t xTaskIncrementTick( void )
          * delayed lists if it wraps to 0. */
         xTickCount = xConstTickCount;
 
+        #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
+        {
+            /* The higher levels of the wheel only need attention when the level
+             * below has completed a revolution.  This must be done before
+             * xNextTaskUnblockTime is recalculated on a tick count overflow. */
+            if( ( xConstTickCount & taskWHEEL_BUCKET_MASK ) == ( TickType_t ) 0U )
+            {
+                prvCascadeDelayedWheel( xConstTickCount );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIMING_WHEEL_DELAY_LIST */
+
         if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
         {
             taskSWITCH_DELAYED_LISTS();
@@ -4683,16 +6800,42 @@ BaseType_t xTaskIncrementTick( void )
          * look any further down the list. */
         if( xConstTickCount >= xNextTaskUnblockTime )
         {
+            #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
+
+                /* Every task in the level 0 bucket for this tick is due now, so
+                 * the bucket is simply emptied.  The pointer is volatile so the
+                 * bucket is read again after each task is removed, as the
+                 * volatile pxDelayedTaskList is when the wheel is not used. */
+                List_t * const volatile pxExpiredTaskList = &( xDelayedTaskWheel[ 0 ][ xConstTickCount & taskWHEEL_BUCKET_MASK ] );
+            #endif
+
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+                    const BaseType_t xExpiredListIsEmpty = listLIST_IS_EMPTY( pxDelayedTaskList );
+                #else
+                    const BaseType_t xExpiredListIsEmpty = listLIST_IS_EMPTY( pxExpiredTaskList );
+                #endif
+
+                if( xExpiredListIsEmpty != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+                    {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    #else
+                    {
+                        /* There are no more tasks to unblock on this tick, so
+                         * find the next tick at which the wheel needs
+                         * attention. */
+                        prvResetNextTaskUnblockTime();
+                    }
+                    #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
                     break;
                 }
                 else
@@ -4701,7 +6844,11 @@ BaseType_t xTaskIncrementTick( void )
                      * item at the head of the delayed list.  This is the time
                      * at which the task at the head of the delayed list must
                      * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    #else
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxExpiredTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    #endif
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -4751,7 +6898,7 @@ BaseType_t xTaskIncrementTick( void )
                              * processing time (which happens when both
                              * preemption and time slicing are on) is
                              * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xSwitchRequired = pdTRUE;
                             }
@@ -4771,6 +6918,19 @@ BaseType_t xTaskIncrementTick( void )
             }
         }
 
+        #if ( configUSE_TASK_BUDGETS == 1 )
+        {
+            if( prvChargeCurrentTaskBudget( xConstTickCount ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_BUDGETS */
+
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
          * writer has not explicitly turned time slicing off. */
@@ -4778,14 +6938,36 @@ BaseType_t xTaskIncrementTick( void )
         {
             #if ( configNUMBER_OF_CORES == 1 )
             {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                #if ( configUSE_EDF_SCHEDULING == 1 )
                 {
-                    xSwitchRequired = pdTRUE;
+                    /* Tasks at configEDF_PRIORITY are not time sliced - the
+                     * running task keeps the processor until a task with an
+                     * earlier deadline is readied. */
+                    if( taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) )
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                    else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-                else
+                #else /* if ( configUSE_EDF_SCHEDULING == 1 ) */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
             }
             #else /* #if ( configNUMBER_OF_CORES == 1 ) */
             {
@@ -4793,7 +6975,7 @@ BaseType_t xTaskIncrementTick( void )
 
                 for( xCoreID = 0; xCoreID < ( ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
                 {
-                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > 1 )
+                    if( taskREADY_TASK_COUNT( pxCurrentTCBs[ xCoreID ]->uxPriority ) > 1U )
                     {
                         xYieldRequiredForCore[ xCoreID ] = pdTRUE;
                     }
@@ -5034,7 +7216,9 @@ BaseType_t xTaskIncrementTick( void )
 
             #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+                    ulTotalRunTime[ 0 ] = prvGetRunTimeCounterValue();
+                #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
                     portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ 0 ] );
                 #else
                     ulTotalRunTime[ 0 ] = portGET_RUN_TIME_COUNTER_VALUE();
@@ -5050,6 +7234,19 @@ BaseType_t xTaskIncrementTick( void )
                 if( ulTotalRunTime[ 0 ] > ulTaskSwitchedInTime[ 0 ] )
                 {
                     pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ] );
+
+                    #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+                    {
+                        if( pxCurrentTCB == xIdleTaskHandles[ 0 ] )
+                        {
+                            ulCoreIdleRunTime[ 0 ] += ( ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ] );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
                 }
                 else
                 {
@@ -5063,6 +7260,9 @@ BaseType_t xTaskIncrementTick( void )
             /* Check for stack overflow, if configured. */
             taskCHECK_FOR_STACK_OVERFLOW();
 
+            /* Record how deep the stack of the task being switched out is. */
+            taskSAMPLE_STACK_HIGH_WATER_MARK( pxCurrentTCB );
+
             /* Before the currently running task is switched out, save its errno. */
             #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -5070,11 +7270,23 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif
 
+            #if ( configUSE_TASK_SNAPSHOTS == 1 )
+            {
+                prvPublishTaskSnapshot( pxCurrentTCB, prvGetSnapshotTaskState( pxCurrentTCB ) );
+            }
+            #endif
+
             /* Select a new task to run using either the generic C or port
              * optimised asm code. */
             taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
             traceTASK_SWITCHED_IN();
 
+            #if ( configUSE_TASK_SNAPSHOTS == 1 )
+            {
+                prvPublishTaskSnapshot( pxCurrentTCB, eRunning );
+            }
+            #endif
+
             /* After the new task is switched in, update the global errno. */
             #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -5089,6 +7301,14 @@ BaseType_t xTaskIncrementTick( void )
                 configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
             }
             #endif
+
+            #if ( configUSE_DYNAMIC_TICK == 1 )
+            {
+                /* The time at which the scheduler next needs to run depends on
+                 * the task that has just been selected. */
+                prvSetNextTickInterrupt();
+            }
+            #endif
         }
 
         traceRETURN_vTaskSwitchContext();
@@ -5127,7 +7347,9 @@ BaseType_t xTaskIncrementTick( void )
 
                 #if ( configGENERATE_RUN_TIME_STATS == 1 )
                 {
-                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+                        ulTotalRunTime[ xCoreID ] = prvGetRunTimeCounterValue();
+                    #elif defined( portALT_GET_RUN_TIME_COUNTER_VALUE )
                         portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime[ xCoreID ] );
                     #else
                         ulTotalRunTime[ xCoreID ] = portGET_RUN_TIME_COUNTER_VALUE();
@@ -5143,6 +7365,21 @@ BaseType_t xTaskIncrementTick( void )
                     if( ulTotalRunTime[ xCoreID ] > ulTaskSwitchedInTime[ xCoreID ] )
                     {
                         pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+
+                        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+                        {
+                            pxCurrentTCBs[ xCoreID ]->ulRunTimeCounterPerCore[ xCoreID ] += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+
+                            if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                            {
+                                ulCoreIdleRunTime[ xCoreID ] += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
                     }
                     else
                     {
@@ -5156,6 +7393,9 @@ BaseType_t xTaskIncrementTick( void )
                 /* Check for stack overflow, if configured. */
                 taskCHECK_FOR_STACK_OVERFLOW();
 
+                /* Record how deep the stack of the task being switched out is. */
+                taskSAMPLE_STACK_HIGH_WATER_MARK( pxCurrentTCBs[ xCoreID ] );
+
                 /* Before the currently running task is switched out, save its errno. */
                 #if ( configUSE_POSIX_ERRNO == 1 )
                 {
@@ -5163,10 +7403,23 @@ BaseType_t xTaskIncrementTick( void )
                 }
                 #endif
 
+                #if ( configUSE_TASK_SNAPSHOTS == 1 )
+                {
+                    prvPublishTaskSnapshot( pxCurrentTCBs[ xCoreID ], prvGetSnapshotTaskState( pxCurrentTCBs[ xCoreID ] ) );
+                }
+                #endif
+
                 /* Select a new task to run. */
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                portSET_CURRENT_TCB( pxCurrentTCBs[ xCoreID ] );
                 traceTASK_SWITCHED_IN();
 
+                #if ( configUSE_TASK_SNAPSHOTS == 1 )
+                {
+                    prvPublishTaskSnapshot( pxCurrentTCBs[ xCoreID ], eRunning );
+                }
+                #endif
+
                 /* After the new task is switched in, update the global errno. */
                 #if ( configUSE_POSIX_ERRNO == 1 )
                 {
@@ -5341,7 +7594,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* Return true if the task removed from the event list has a higher
              * priority than the calling task.  This allows the calling task to know if
@@ -5421,7 +7674,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* The unblocked task has a priority above that of the calling task, so
              * a context switch is required.  This function is called with the
@@ -5456,7 +7709,7 @@ void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
     taskENTER_CRITICAL();
     {
         pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
+        pxTimeOut->xTimeOnEntering = taskGET_TICK_COUNT_NOW();
     }
     taskEXIT_CRITICAL();
 
@@ -5470,7 +7723,7 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
 
     /* For internal use only as it does not use a critical section. */
     pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
+    pxTimeOut->xTimeOnEntering = taskGET_TICK_COUNT_NOW();
 
     traceRETURN_vTaskInternalSetTimeOutState();
 }
@@ -5489,7 +7742,7 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
     taskENTER_CRITICAL();
     {
         /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xConstTickCount = taskGET_TICK_COUNT_NOW();
         const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
 
         #if ( INCLUDE_xTaskAbortDelay == 1 )
@@ -5650,7 +7903,7 @@ void vTaskMissedYield( void )
                  * the ready list at the idle priority contains one more task than the
                  * number of idle tasks, which is equal to the configured numbers of cores
                  * then a task other than the idle task is ready to execute. */
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
                 {
                     taskYIELD();
                 }
@@ -5739,7 +7992,7 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * the ready list at the idle priority contains one more task than the
              * number of idle tasks, which is equal to the configured numbers of cores
              * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+            if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -5950,20 +8203,53 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
         traceRETURN_vTaskAllocateMPURegions();
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
-/*-----------------------------------------------------------*/
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
+
+    #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+    {
+        BaseType_t xCoreID;
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+            {
+                vListInitialise( &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] ) );
+            }
+        }
+    }
+    #endif /* configUSE_PER_CORE_READY_LISTS */
+
+    #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+    }
+    #else
+    {
+        UBaseType_t uxLevel, uxBucket;
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+        {
+            for( uxBucket = 0U; uxBucket < taskWHEEL_BUCKETS_PER_LEVEL; uxBucket++ )
+            {
+                vListInitialise( &( xDelayedTaskWheel[ uxLevel ][ uxBucket ] ) );
+            }
+        }
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
-    {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        vListInitialise( &xDelayedTaskWheelOverflow );
     }
+    #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -5978,10 +8264,14 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -6159,7 +8449,11 @@ static void prvCheckTasksWaitingTermination( void )
          * parameter is provided to allow it to be skipped. */
         if( xGetFreeStackSpace != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
+            #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+            {
+                pxTaskStatus->usStackHighWaterMark = prvGetIncrementalStackHighWaterMark( pxTCB );
+            }
+            #elif ( portSTACK_GROWTH > 0 )
             {
                 pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
             }
@@ -6216,7 +8510,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 0 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
 
     static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
     {
@@ -6233,7 +8527,115 @@ static void prvCheckTasksWaitingTermination( void )
         return ( configSTACK_DEPTH_TYPE ) ulCount;
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 0 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) )
+
+    static configSTACK_DEPTH_TYPE prvGetIncrementalStackHighWaterMark( TCB_t * pxTCB )
+    {
+        StackType_t * pxHighWaterMark;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        pxHighWaterMark = pxTCB->pxStackHighWaterMark;
+
+        #if ( configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN == 1 )
+        {
+            StackType_t * pxScan = pxHighWaterMark;
+            UBaseType_t uxFillWordsSeen = 0U;
+
+            /* Usage that did not coincide with a context switch, including
+             * the current usage of the calling task, leaves no trace in the
+             * sampled mark but does overwrite the fill value.  Extend the mark
+             * by scanning a word at a time from where the previous scan
+             * finished, stopping once
+             * configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW consecutive
+             * words that still hold the fill value have been seen.  Shorter
+             * runs are assumed to be parts of stack frames that were never
+             * written.  Words behind the mark are never scanned again, so the
+             * cost of a call does not depend on the stack size. */
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                while( ( pxScan > pxTCB->pxStack ) && ( uxFillWordsSeen < ( UBaseType_t ) configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW ) )
+                {
+                    pxScan--;
+
+                    if( *pxScan == tskSTACK_FILL_WORD )
+                    {
+                        uxFillWordsSeen++;
+                    }
+                    else
+                    {
+                        uxFillWordsSeen = 0U;
+                        pxHighWaterMark = pxScan;
+                    }
+                }
+            }
+            #else
+            {
+                while( ( pxScan < pxTCB->pxEndOfStack ) && ( uxFillWordsSeen < ( UBaseType_t ) configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN_WINDOW ) )
+                {
+                    pxScan++;
+
+                    if( *pxScan == tskSTACK_FILL_WORD )
+                    {
+                        uxFillWordsSeen++;
+                    }
+                    else
+                    {
+                        uxFillWordsSeen = 0U;
+                        pxHighWaterMark = pxScan;
+                    }
+                }
+            }
+            #endif /* portSTACK_GROWTH */
+
+            /* The task may have been switched out, and the mark updated, while
+             * the stack was being scanned, so only ever move the mark deeper. */
+            taskENTER_CRITICAL();
+            {
+                #if ( portSTACK_GROWTH < 0 )
+                {
+                    if( pxHighWaterMark < pxTCB->pxStackHighWaterMark )
+                    {
+                        pxTCB->pxStackHighWaterMark = pxHighWaterMark;
+                    }
+                    else
+                    {
+                        pxHighWaterMark = pxTCB->pxStackHighWaterMark;
+                    }
+                }
+                #else
+                {
+                    if( pxHighWaterMark > pxTCB->pxStackHighWaterMark )
+                    {
+                        pxTCB->pxStackHighWaterMark = pxHighWaterMark;
+                    }
+                    else
+                    {
+                        pxHighWaterMark = pxTCB->pxStackHighWaterMark;
+                    }
+                }
+                #endif /* portSTACK_GROWTH */
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif /* configINCREMENTAL_STACK_HIGH_WATER_MARK_SCAN */
+
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            uxReturn = ( configSTACK_DEPTH_TYPE ) ( pxHighWaterMark - pxTCB->pxStack );
+        }
+        #else
+        {
+            uxReturn = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxHighWaterMark );
+        }
+        #endif
+
+        return uxReturn;
+    }
+
+#endif /* ( ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 ) && ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
@@ -6246,7 +8648,6 @@ static void prvCheckTasksWaitingTermination( void )
     configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         configSTACK_DEPTH_TYPE uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark2( xTask );
@@ -6260,17 +8661,27 @@ static void prvCheckTasksWaitingTermination( void )
 
         pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
+        #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            uxReturn = prvGetIncrementalStackHighWaterMark( pxTCB );
         }
         #else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            uint8_t * pucEndOfStack;
+
+            #if portSTACK_GROWTH < 0
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            }
+            #else
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            }
+            #endif
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+            uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        }
+        #endif /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
 
         traceRETURN_uxTaskGetStackHighWaterMark2( uxReturn );
 
@@ -6285,24 +8696,33 @@ static void prvCheckTasksWaitingTermination( void )
     UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
         UBaseType_t uxReturn;
 
         traceENTER_uxTaskGetStackHighWaterMark( xTask );
 
         pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
+        #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            uxReturn = ( UBaseType_t ) prvGetIncrementalStackHighWaterMark( pxTCB );
         }
         #else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            uint8_t * pucEndOfStack;
+
+            #if portSTACK_GROWTH < 0
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            }
+            #else
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            }
+            #endif
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+            uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        }
+        #endif /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
 
         traceRETURN_uxTaskGetStackHighWaterMark( uxReturn );
 
@@ -6316,6 +8736,20 @@ static void prvCheckTasksWaitingTermination( void )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
     {
+        #if ( configUSE_TASK_NAME_INDEX == 1 )
+        {
+            /* The task can be found by xTaskGetHandle() until its memory is
+             * released, as is the case when the index is not used. */
+            prvRemoveTaskFromNameIndex( pxTCB );
+        }
+        #endif
+
+        #if ( configUSE_TASK_SNAPSHOTS == 1 )
+        {
+            prvReleaseTaskSnapshot( pxTCB );
+        }
+        #endif
+
         /* This call is required specifically for the TriCore port.  It must be
          * above the vPortFree() calls.  The call is also used by ports/demos that
          * want to allocate and clean RAM statically. */
@@ -6328,7 +8762,7 @@ static void prvCheckTasksWaitingTermination( void )
         }
         #endif
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) && ( configUSE_TASK_BATCH_CREATION == 0 ) )
         {
             /* The task can only have been allocated dynamically - free both
              * the stack and TCB. */
@@ -6355,9 +8789,11 @@ static void prvCheckTasksWaitingTermination( void )
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                /* Neither the stack nor the TCB were allocated dynamically, or
+                 * they are part of a block shared with other tasks created by
+                 * xTaskCreateBatch(), so nothing needs to be freed. */
+                configASSERT( ( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB ) ||
+                              ( pxTCB->ucStaticallyAllocated == tskBATCH_ALLOCATED_STACK_AND_TCB ) );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
@@ -6367,25 +8803,233 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+#if defined( taskUSE_PORTABLE_FIND_HIGHEST_SET_BIT )
+
+    static UBaseType_t prvFindHighestSetBit( uint32_t ulBitmap )
     {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
+        UBaseType_t uxBit = 0U;
+
+        if( ( ulBitmap & 0xFFFF0000UL ) != 0UL )
+        {
+            ulBitmap >>= 16U;
+            uxBit += 16U;
+        }
+
+        if( ( ulBitmap & 0x0000FF00UL ) != 0UL )
+        {
+            ulBitmap >>= 8U;
+            uxBit += 8U;
+        }
+
+        if( ( ulBitmap & 0x000000F0UL ) != 0UL )
+        {
+            ulBitmap >>= 4U;
+            uxBit += 4U;
+        }
+
+        if( ( ulBitmap & 0x0000000CUL ) != 0UL )
+        {
+            ulBitmap >>= 2U;
+            uxBit += 2U;
+        }
+
+        if( ( ulBitmap & 0x00000002UL ) != 0UL )
+        {
+            uxBit += 1U;
+        }
+
+        return uxBit;
     }
-    else
+
+#endif /* taskUSE_PORTABLE_FIND_HIGHEST_SET_BIT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 )
+
+    static void prvResetNextTaskUnblockTime( void )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
     }
-}
+
+#else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
+
+    static void prvResetNextTaskUnblockTime( void )
+    {
+        const TickType_t xConstTickCount = xTickCount;
+        TickType_t xTicksToNextEvent = portMAX_DELAY;
+        TickType_t xSlot, xEventTime;
+        UBaseType_t uxLevel, uxOffset, uxFirstOffset;
+
+        /* When the wheel is in use xNextTaskUnblockTime is the earliest tick at
+         * which the wheel needs attention - either because a task in level 0
+         * is due, or because a higher level bucket is due to be cascaded into
+         * the levels below.  The time at which a bucket needs attention can be
+         * derived from its index, so only the first occupied bucket in each
+         * level is considered and no task lists are walked. */
+        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+        {
+            xSlot = xConstTickCount >> taskWHEEL_LEVEL_SHIFT( uxLevel );
+
+            /* Level 0 may hold tasks that are due on this tick, whereas the
+             * current bucket of a higher level has already been cascaded and
+             * so will not need attention until a full revolution later. */
+            uxFirstOffset = ( uxLevel == 0U ) ? 0U : 1U;
+
+            for( uxOffset = uxFirstOffset; uxOffset < ( uxFirstOffset + taskWHEEL_BUCKETS_PER_LEVEL ); uxOffset++ )
+            {
+                if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxLevel ][ ( xSlot + uxOffset ) & taskWHEEL_BUCKET_MASK ] ) ) == pdFALSE )
+                {
+                    xEventTime = ( TickType_t ) ( ( xSlot + uxOffset ) << taskWHEEL_LEVEL_SHIFT( uxLevel ) );
+
+                    if( ( TickType_t ) ( xEventTime - xConstTickCount ) < xTicksToNextEvent )
+                    {
+                        xTicksToNextEvent = ( TickType_t ) ( xEventTime - xConstTickCount );
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        if( listLIST_IS_EMPTY( &xDelayedTaskWheelOverflow ) == pdFALSE )
+        {
+            /* Tasks beyond the span of the wheel are reconsidered each time
+             * the outermost level completes a revolution. */
+            xEventTime = ( TickType_t ) ( ( ( xConstTickCount >> taskWHEEL_LEVEL_SHIFT( configTIMING_WHEEL_LEVELS ) ) + ( TickType_t ) 1U ) << taskWHEEL_LEVEL_SHIFT( configTIMING_WHEEL_LEVELS ) );
+
+            if( ( TickType_t ) ( xEventTime - xConstTickCount ) < xTicksToNextEvent )
+            {
+                xTicksToNextEvent = ( TickType_t ) ( xEventTime - xConstTickCount );
+            }
+        }
+
+        xNextTaskUnblockTime = xConstTickCount + xTicksToNextEvent;
+
+        if( xNextTaskUnblockTime < xConstTickCount )
+        {
+            /* The next event is after the tick count overflows, or there is
+             * no event at all.  xNextTaskUnblockTime is recalculated when the
+             * tick count overflows. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertIntoDelayedWheel( ListItem_t * const pxListItem,
+                                           const TickType_t xTimeNow )
+    {
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxListItem );
+        const TickType_t xTicksToWake = xTimeToWake - xTimeNow;
+
+        /* Volatile for the reason given in prvCascadeDelayedWheel(). */
+        List_t * volatile pxBucket = &xDelayedTaskWheelOverflow;
+        TickType_t xEventTime;
+        UBaseType_t uxLevel;
+
+        /* By default the task is beyond the span of the wheel, in which case it
+         * is next considered when the outermost level completes a revolution. */
+        xEventTime = ( TickType_t ) ( ( ( xTimeNow >> taskWHEEL_LEVEL_SHIFT( configTIMING_WHEEL_LEVELS ) ) + ( TickType_t ) 1U ) << taskWHEEL_LEVEL_SHIFT( configTIMING_WHEEL_LEVELS ) );
+
+        /* Use the lowest level that spans the time until the task wakes.  A
+         * bucket above level 0 is cascaded into the levels below when the tick
+         * count reaches the start of the range of wake times it covers. */
+        for( uxLevel = 0U; uxLevel < ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel++ )
+        {
+            if( ( xTicksToWake >> taskWHEEL_LEVEL_SHIFT( uxLevel + 1U ) ) == ( TickType_t ) 0U )
+            {
+                pxBucket = &( xDelayedTaskWheel[ uxLevel ][ ( xTimeToWake >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) & taskWHEEL_BUCKET_MASK ] );
+                xEventTime = ( TickType_t ) ( ( xTimeToWake >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) << taskWHEEL_LEVEL_SHIFT( uxLevel ) );
+                break;
+            }
+        }
+
+        listINSERT_END( pxBucket, pxListItem );
+
+        /* If the event time has overflowed it is picked up when
+         * xNextTaskUnblockTime is recalculated on the tick count overflowing. */
+        if( ( xEventTime >= xTimeNow ) && ( xEventTime < xNextTaskUnblockTime ) )
+        {
+            xNextTaskUnblockTime = xEventTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCascadeDelayedWheel( const TickType_t xTimeNow )
+    {
+        UBaseType_t uxLevel, uxItems;
+        ListItem_t * pxListItem;
+
+        /* The bucket is accessed through a volatile pointer, as the delayed
+         * task lists are, so the end marker of the bucket is read again after
+         * listREMOVE_ITEM() writes to it through a ListItem_t pointer.  The end
+         * marker is a MiniListItem_t, so otherwise a compiler that applies
+         * strict aliasing rules can use a stale copy of the head of the
+         * bucket. */
+        List_t * volatile pxBucket;
+
+        /* Work from the outermost level inwards so tasks cascaded from a higher
+         * level are cascaded again if the level below is also due on this
+         * tick. */
+        for( uxLevel = ( UBaseType_t ) configTIMING_WHEEL_LEVELS; uxLevel > 0U; uxLevel-- )
+        {
+            if( ( xTimeNow & ( ( ( TickType_t ) 1U << taskWHEEL_LEVEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+            {
+                if( uxLevel == ( UBaseType_t ) configTIMING_WHEEL_LEVELS )
+                {
+                    pxBucket = &xDelayedTaskWheelOverflow;
+
+                    /* The list index may have been moved by a debug function
+                     * walking the list.  It must reference the end marker for
+                     * tasks placed back on this list to be inserted after the
+                     * tasks that have not yet been moved. */
+                    pxBucket->pxIndex = ( ListItem_t * ) &( pxBucket->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+                }
+                else
+                {
+                    pxBucket = &( xDelayedTaskWheel[ uxLevel ][ ( xTimeNow >> taskWHEEL_LEVEL_SHIFT( uxLevel ) ) & taskWHEEL_BUCKET_MASK ] );
+                }
+
+                /* Tasks that are still beyond the span of the wheel are placed
+                 * back at the end of the overflow list, so only the number of
+                 * items originally in the bucket are moved. */
+                for( uxItems = listCURRENT_LIST_LENGTH( pxBucket ); uxItems > 0U; uxItems-- )
+                {
+                    pxListItem = listGET_HEAD_ENTRY( pxBucket );
+                    listREMOVE_ITEM( pxListItem );
+                    prvInsertIntoDelayedWheel( pxListItem, xTimeNow );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 0 ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
@@ -6410,15 +9054,28 @@ static void prvResetNextTaskUnblockTime( void )
         TaskHandle_t xTaskGetCurrentTaskHandle( void )
         {
             TaskHandle_t xReturn;
-            UBaseType_t uxSavedInterruptStatus;
 
             traceENTER_xTaskGetCurrentTaskHandle();
 
-            uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+            #ifdef portGET_CURRENT_TCB
+            {
+                /* The running task is read from core-local storage in a
+                 * single access, so the calling task cannot move to another
+                 * core part way through and there is no need to mask
+                 * interrupts. */
+                xReturn = taskGET_CURRENT_TCB_FOR_THIS_CORE();
+            }
+            #else
             {
-                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+                UBaseType_t uxSavedInterruptStatus;
+
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+                {
+                    xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+                }
+                portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
             }
-            portCLEAR_INTERRUPT_MASK( uxSavedInterruptStatus );
+            #endif /* ifdef portGET_CURRENT_TCB */
 
             traceRETURN_xTaskGetCurrentTaskHandle( xReturn );
 
@@ -6517,7 +9174,7 @@ static void prvResetNextTaskUnblockTime( void )
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskGET_READY_LIST( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
                 {
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
@@ -6549,6 +9206,13 @@ static void prvResetNextTaskUnblockTime( void )
                 {
                     /* Just inherit the priority. */
                     pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+
+                    #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                    {
+                        /* The mutex holder may itself be blocked on a mutex. */
+                        prvReorderEventListItem( pxMutexHolderTCB );
+                    }
+                    #endif
                 }
 
                 traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
@@ -6750,7 +9414,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * from its current state list if it is in the Ready state as
                      * the task's priority is going to change and there is one
                      * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    if( listIS_CONTAINED_WITHIN( taskGET_READY_LIST( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                     {
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
@@ -6778,7 +9442,17 @@ static void prvResetNextTaskUnblockTime( void )
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        #if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+                        {
+                            /* The mutex holder may itself be blocked on a
+                             * mutex. */
+                            prvReorderEventListItem( pxTCB );
+                        }
+                        #else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        #endif
                     }
                 }
                 else
@@ -6796,10 +9470,66 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        traceENTER_vTaskPriorityRaiseToCeiling( uxCeilingPriority );
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        /* A task must not take a priority ceiling mutex whose ceiling is below
+         * the task's own priority, as then the mutex would not prevent other
+         * tasks that use it from preempting the holder. */
+        configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+        if( pxTCB->uxPriority < uxCeilingPriority )
+        {
+            /* Only reset the event list item value if the value is not being
+             * used for anything else. */
+            if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The calling task is running, so is in its ready list.  Raising
+             * its priority cannot cause it to be preempted, so no yield is
+             * needed. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->uxPriority = uxCeilingPriority;
+            prvAddTaskToReadyList( pxTCB );
+
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskPriorityRaiseToCeiling();
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES > 1 )
@@ -6877,6 +9607,15 @@ static void prvResetNextTaskUnblockTime( void )
                 portGET_ISR_LOCK();
             }
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                /* The kernel locks must not be taken while an object spinlock
+                 * is held, otherwise two cores can deadlock. */
+                configASSERT( ( portGET_CRITICAL_NESTING_COUNT() == 0U ) ||
+                              ( portGET_CRITICAL_NESTING_COUNT() != uxObjectCriticalNesting[ portGET_CORE_ID() ] ) );
+            }
+            #endif
+
             portINCREMENT_CRITICAL_NESTING_COUNT();
 
             /* This is not the interrupt safe version of the enter critical
@@ -6928,6 +9667,13 @@ static void prvResetNextTaskUnblockTime( void )
                 portGET_ISR_LOCK();
             }
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                configASSERT( ( portGET_CRITICAL_NESTING_COUNT() == 0U ) ||
+                              ( portGET_CRITICAL_NESTING_COUNT() != uxObjectCriticalNesting[ portGET_CORE_ID() ] ) );
+            }
+            #endif
+
             portINCREMENT_CRITICAL_NESTING_COUNT();
         }
         else
@@ -7091,6 +9837,165 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskEnterObjectCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskEnterObjectCritical( pxSpinlock );
+
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            portGET_SPINLOCK( xCoreID, pxSpinlock );
+
+            /* The object critical section is counted in the critical nesting
+             * count so interrupts remain disabled, and any yield is held
+             * pending, until the outermost critical section is exited. */
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+            uxObjectCriticalNesting[ xCoreID ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskEnterObjectCritical();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskExitObjectCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskExitObjectCritical( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            configASSERT( uxObjectCriticalNesting[ xCoreID ] > 0U );
+
+            portASSERT_IF_IN_ISR();
+
+            if( uxObjectCriticalNesting[ xCoreID ] > 0U )
+            {
+                uxObjectCriticalNesting[ xCoreID ]--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+                portRELEASE_SPINLOCK( xCoreID, pxSpinlock );
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    const BaseType_t xYieldCurrentTask = xYieldPendings[ xCoreID ];
+
+                    portENABLE_INTERRUPTS();
+
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskExitObjectCritical();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    UBaseType_t uxTaskEnterObjectCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        traceENTER_uxTaskEnterObjectCriticalFromISR( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            BaseType_t xCoreID;
+
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            portGET_SPINLOCK( xCoreID, pxSpinlock );
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+            uxObjectCriticalNesting[ xCoreID ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxTaskEnterObjectCriticalFromISR( uxSavedInterruptStatus );
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskExitObjectCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock,
+                                         UBaseType_t uxSavedInterruptStatus )
+    {
+        traceENTER_vTaskExitObjectCriticalFromISR( pxSpinlock, uxSavedInterruptStatus );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+            configASSERT( uxObjectCriticalNesting[ xCoreID ] > 0U );
+
+            if( uxObjectCriticalNesting[ xCoreID ] > 0U )
+            {
+                uxObjectCriticalNesting[ xCoreID ]--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+                portRELEASE_SPINLOCK( xCoreID, pxSpinlock );
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskExitObjectCriticalFromISR();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
     static char * prvWriteNameToBuffer( char * pcBuffer,
@@ -7406,39 +10311,310 @@ static void prvResetNextTaskUnblockTime( void )
                                 #endif /* ifdef portLU_PRINTF_SPECIFIER_REQUIRED */
                             }
 
-                            uxCharsWrittenBySnprintf = prvSnprintfReturnValueToCharsWritten( iSnprintfReturnValue, uxBufferLength - uxConsumedBufferLength );
-                            uxConsumedBufferLength += uxCharsWrittenBySnprintf;
-                            pcWriteBuffer += uxCharsWrittenBySnprintf; /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
-                        }
-                        else
-                        {
-                            xOutputBufferFull = pdTRUE;
-                        }
-                    }
-                    else
+                            uxCharsWrittenBySnprintf = prvSnprintfReturnValueToCharsWritten( iSnprintfReturnValue, uxBufferLength - uxConsumedBufferLength );
+                            uxConsumedBufferLength += uxCharsWrittenBySnprintf;
+                            pcWriteBuffer += uxCharsWrittenBySnprintf; /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                        }
+                        else
+                        {
+                            xOutputBufferFull = pdTRUE;
+                        }
+                    }
+                    else
+                    {
+                        xOutputBufferFull = pdTRUE;
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskGetRunTimeStatistics();
+    }
+
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_ENCODING_FUNCTIONS == 1 ) )
+
+/* The record types and format version written by xTaskStatsEncode().  These
+ * must be kept in step with tools/task_stats_decoder.py. */
+    #define taskSTATS_FORMAT_VERSION    ( ( uint8_t ) 1U )
+    #define taskSTATS_RECORD_FRAME      ( ( uint8_t ) 1U )
+    #define taskSTATS_RECORD_TASK       ( ( uint8_t ) 2U )
+    #define taskSTATS_RECORD_NAME       ( ( uint8_t ) 3U )
+    #define taskSTATS_FLAG_DELTA        ( ( uint8_t ) 1U )
+
+/* The number of characters of a task's name held in a name record. */
+    #define taskSTATS_NAME_LENGTH       ( ( size_t ) 11U )
+
+    static void prvStatsPutUInt16( uint8_t * pucDestination,
+                                   uint16_t usValue )
+    {
+        pucDestination[ 0 ] = ( uint8_t ) usValue;
+        pucDestination[ 1 ] = ( uint8_t ) ( usValue >> 8 );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStatsPutUInt32( uint8_t * pucDestination,
+                                   uint32_t ulValue )
+    {
+        pucDestination[ 0 ] = ( uint8_t ) ulValue;
+        pucDestination[ 1 ] = ( uint8_t ) ( ulValue >> 8 );
+        pucDestination[ 2 ] = ( uint8_t ) ( ulValue >> 16 );
+        pucDestination[ 3 ] = ( uint8_t ) ( ulValue >> 24 );
+    }
+/*-----------------------------------------------------------*/
+
+    static const TaskStatus_t * prvStatsFindPrevious( const TaskStatsEncoder_t * pxEncoder,
+                                                      UBaseType_t uxTaskNumberToFind )
+    {
+        const TaskStatus_t * pxReturn = NULL;
+        UBaseType_t x;
+
+        if( ( pxEncoder->pxPrevious != NULL ) && ( pxEncoder->xHavePrevious != pdFALSE ) )
+        {
+            for( x = ( UBaseType_t ) 0; x < pxEncoder->uxPreviousTasks; x++ )
+            {
+                if( pxEncoder->pxPrevious[ x ].xTaskNumber == uxTaskNumberToFind )
+                {
+                    pxReturn = &( pxEncoder->pxPrevious[ x ] );
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStatsWriteRecord( const uint8_t * pucRecord,
+                                     uint8_t * pucBuffer,
+                                     StreamBufferHandle_t xStreamBuffer,
+                                     size_t * pxBytesWritten )
+    {
+        if( xStreamBuffer != NULL )
+        {
+            /* Space for the whole frame was checked before the first record
+             * was written, so this cannot block or write a partial record. */
+            ( void ) xStreamBufferSend( xStreamBuffer, pucRecord, tskSTATS_RECORD_SIZE, 0 );
+        }
+        else
+        {
+            ( void ) memcpy( &( pucBuffer[ *pxBytesWritten ] ), pucRecord, tskSTATS_RECORD_SIZE );
+        }
+
+        *pxBytesWritten += tskSTATS_RECORD_SIZE;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvStatsEncodeFrame( TaskStatsEncoder_t * pxEncoder,
+                                       uint8_t * pucBuffer,
+                                       size_t xBufferLength,
+                                       StreamBufferHandle_t xStreamBuffer )
+    {
+        uint8_t ucRecord[ tskSTATS_RECORD_SIZE ];
+        configRUN_TIME_COUNTER_TYPE ulTotalTime = 0;
+        configRUN_TIME_COUNTER_TYPE ulRunTime;
+        uint32_t ulStackHighWaterMark;
+        const TaskStatus_t * pxTask;
+        const TaskStatus_t * pxPrevious;
+        TaskStatus_t * pxSwap;
+        UBaseType_t uxTasks, uxNames = 0, x;
+        size_t xFrameSize, xBytesWritten = 0, xNameLength;
+        uint8_t ucFlags = 0U;
+
+        uxTasks = uxTaskGetSystemState( pxEncoder->pxCurrent, pxEncoder->uxMaxTasks, &ulTotalTime );
+
+        /* Name records are written for the tasks that were not in the previous
+         * frame, or for all the tasks if this is not a delta frame. */
+        for( x = ( UBaseType_t ) 0; x < uxTasks; x++ )
+        {
+            if( prvStatsFindPrevious( pxEncoder, pxEncoder->pxCurrent[ x ].xTaskNumber ) == NULL )
+            {
+                uxNames++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        xFrameSize = tskSTATS_RECORD_SIZE * ( ( size_t ) 1U + ( size_t ) uxTasks + ( size_t ) uxNames );
+
+        if( xStreamBuffer != NULL )
+        {
+            xBufferLength = xStreamBufferSpacesAvailable( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* uxTaskGetSystemState() returns 0 if there are more than uxMaxTasks
+         * tasks.  Only write complete frames so the host stays in step with
+         * the record boundaries. */
+        if( ( uxTasks > ( UBaseType_t ) 0 ) && ( xFrameSize <= xBufferLength ) )
+        {
+            if( ( pxEncoder->pxPrevious != NULL ) && ( pxEncoder->xHavePrevious != pdFALSE ) )
+            {
+                ucFlags = taskSTATS_FLAG_DELTA;
+                ulRunTime = ulTotalTime - pxEncoder->ulPreviousTotalRunTime;
+            }
+            else
+            {
+                ulRunTime = ulTotalTime;
+            }
+
+            ( void ) memset( ucRecord, 0x00, sizeof( ucRecord ) );
+            ucRecord[ 0 ] = taskSTATS_RECORD_FRAME;
+            ucRecord[ 1 ] = taskSTATS_FORMAT_VERSION;
+            ucRecord[ 2 ] = ucFlags;
+            prvStatsPutUInt16( &( ucRecord[ 4 ] ), ( uint16_t ) ( uxTasks + uxNames ) );
+            prvStatsPutUInt32( &( ucRecord[ 8 ] ), ( uint32_t ) ulRunTime );
+            prvStatsPutUInt32( &( ucRecord[ 12 ] ), ( uint32_t ) xTaskGetTickCount() );
+            prvStatsWriteRecord( ucRecord, pucBuffer, xStreamBuffer, &xBytesWritten );
+
+            for( x = ( UBaseType_t ) 0; x < uxTasks; x++ )
+            {
+                pxTask = &( pxEncoder->pxCurrent[ x ] );
+                pxPrevious = prvStatsFindPrevious( pxEncoder, pxTask->xTaskNumber );
+
+                if( pxPrevious == NULL )
+                {
+                    ( void ) memset( ucRecord, 0x00, sizeof( ucRecord ) );
+                    ucRecord[ 0 ] = taskSTATS_RECORD_NAME;
+
+                    for( xNameLength = 0; ( xNameLength < taskSTATS_NAME_LENGTH ) && ( pxTask->pcTaskName[ xNameLength ] != ( char ) 0x00 ); xNameLength++ )
                     {
-                        xOutputBufferFull = pdTRUE;
+                        ucRecord[ 1U + xNameLength ] = ( uint8_t ) pxTask->pcTaskName[ xNameLength ];
                     }
+
+                    prvStatsPutUInt32( &( ucRecord[ 12 ] ), ( uint32_t ) pxTask->xTaskNumber );
+                    prvStatsWriteRecord( ucRecord, pucBuffer, xStreamBuffer, &xBytesWritten );
+
+                    ulRunTime = pxTask->ulRunTimeCounter;
+                }
+                else
+                {
+                    ulRunTime = pxTask->ulRunTimeCounter - pxPrevious->ulRunTimeCounter;
                 }
+
+                ulStackHighWaterMark = ( uint32_t ) pxTask->usStackHighWaterMark;
+
+                ( void ) memset( ucRecord, 0x00, sizeof( ucRecord ) );
+                ucRecord[ 0 ] = taskSTATS_RECORD_TASK;
+                ucRecord[ 1 ] = ( uint8_t ) pxTask->eCurrentState;
+                ucRecord[ 2 ] = ( pxTask->uxCurrentPriority > ( UBaseType_t ) 0xFFU ) ? ( uint8_t ) 0xFFU : ( uint8_t ) pxTask->uxCurrentPriority;
+                ucRecord[ 3 ] = ( pxTask->uxBasePriority > ( UBaseType_t ) 0xFFU ) ? ( uint8_t ) 0xFFU : ( uint8_t ) pxTask->uxBasePriority;
+                prvStatsPutUInt32( &( ucRecord[ 4 ] ), ( uint32_t ) pxTask->xTaskNumber );
+                prvStatsPutUInt32( &( ucRecord[ 8 ] ), ( uint32_t ) ulRunTime );
+                prvStatsPutUInt16( &( ucRecord[ 12 ] ), ( ulStackHighWaterMark > 0xFFFFUL ) ? ( uint16_t ) 0xFFFFU : ( uint16_t ) ulStackHighWaterMark );
+                prvStatsWriteRecord( ucRecord, pucBuffer, xStreamBuffer, &xBytesWritten );
+            }
+
+            /* The tasks just encoded are the reference for the next frame. */
+            if( pxEncoder->pxPrevious != NULL )
+            {
+                pxSwap = pxEncoder->pxPrevious;
+                pxEncoder->pxPrevious = pxEncoder->pxCurrent;
+                pxEncoder->pxCurrent = pxSwap;
+                pxEncoder->uxPreviousTasks = uxTasks;
+                pxEncoder->ulPreviousTotalRunTime = ulTotalTime;
+                pxEncoder->xHavePrevious = pdTRUE;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskGetRunTimeStatistics();
+        return xBytesWritten;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskStatsEncoderInitialise( TaskStatsEncoder_t * pxEncoder,
+                                      TaskStatus_t * pxTaskStatusArrays,
+                                      UBaseType_t uxMaxTasks,
+                                      BaseType_t xDeltaEncode )
+    {
+        traceENTER_vTaskStatsEncoderInitialise( pxEncoder, pxTaskStatusArrays, uxMaxTasks, xDeltaEncode );
+
+        configASSERT( pxEncoder != NULL );
+        configASSERT( pxTaskStatusArrays != NULL );
+        configASSERT( uxMaxTasks > ( UBaseType_t ) 0 );
+
+        pxEncoder->pxCurrent = pxTaskStatusArrays;
+        pxEncoder->pxPrevious = ( xDeltaEncode != pdFALSE ) ? &( pxTaskStatusArrays[ uxMaxTasks ] ) : NULL;
+        pxEncoder->uxMaxTasks = uxMaxTasks;
+        pxEncoder->uxPreviousTasks = ( UBaseType_t ) 0;
+        pxEncoder->ulPreviousTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        pxEncoder->xHavePrevious = pdFALSE;
+
+        traceRETURN_vTaskStatsEncoderInitialise();
     }
+/*-----------------------------------------------------------*/
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+    size_t xTaskStatsEncode( TaskStatsEncoder_t * pxEncoder,
+                             uint8_t * pucBuffer,
+                             size_t xBufferLength )
+    {
+        size_t xBytesWritten;
+
+        traceENTER_xTaskStatsEncode( pxEncoder, pucBuffer, xBufferLength );
+
+        configASSERT( pxEncoder != NULL );
+        configASSERT( pucBuffer != NULL );
+
+        xBytesWritten = prvStatsEncodeFrame( pxEncoder, pucBuffer, xBufferLength, NULL );
+
+        traceRETURN_xTaskStatsEncode( xBytesWritten );
+
+        return xBytesWritten;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xTaskStatsEncodeToStreamBuffer( TaskStatsEncoder_t * pxEncoder,
+                                           StreamBufferHandle_t xStreamBuffer )
+    {
+        size_t xBytesWritten;
+
+        traceENTER_xTaskStatsEncodeToStreamBuffer( pxEncoder, xStreamBuffer );
+
+        configASSERT( pxEncoder != NULL );
+        configASSERT( xStreamBuffer != NULL );
+
+        xBytesWritten = prvStatsEncodeFrame( pxEncoder, NULL, 0, xStreamBuffer );
+
+        traceRETURN_xTaskStatsEncodeToStreamBuffer( xBytesWritten );
+
+        return xBytesWritten;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_ENCODING_FUNCTIONS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 TickType_t uxTaskResetEventItemValue( void )
@@ -7484,6 +10660,130 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+    BaseType_t xTaskDecrementMutexHeldCount( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskDecrementMutexHeldCount();
+
+        /* Only the task itself changes its mutex held count, so the count can
+         * be decremented outside of a critical section - unless the task has
+         * inherited a priority, which may have to be disinherited. */
+        if( pxTCB->uxPriority == pxTCB->uxBasePriority )
+        {
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        traceRETURN_xTaskDecrementMutexHeldCount( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    void vTaskSetBlockingMutex( void * pvMutex )
+    {
+        traceENTER_vTaskSetBlockingMutex( pvMutex );
+
+        /* Only the task itself writes this, and a single pointer is written
+         * atomically, so a task walking the chain of mutex holders reads
+         * either the old or the new value. */
+        pxCurrentTCB->pvBlockingMutex = pvMutex;
+
+        traceRETURN_vTaskSetBlockingMutex();
+    }
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    void * pvTaskGetBlockingMutex( TaskHandle_t xTask )
+    {
+        TCB_t * const pxTCB = xTask;
+        void * pvReturn;
+
+        traceENTER_pvTaskGetBlockingMutex( xTask );
+
+        configASSERT( pxTCB != NULL );
+
+        pvReturn = pxTCB->pvBlockingMutex;
+
+        traceRETURN_pvTaskGetBlockingMutex( pvReturn );
+
+        return pvReturn;
+    }
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ADAPTIVE_MUTEXES == 1 )
+
+    BaseType_t xTaskIsRunningOnAnotherCore( TaskHandle_t xTask )
+    {
+        const TCB_t * const pxTCB = xTask;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskIsRunningOnAnotherCore( xTask );
+
+        configASSERT( pxTCB != NULL );
+
+        /* This is called without entering a critical section, so the result is
+         * only a hint - the task can stop running at any time. */
+        if( ( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE ) && ( pxTCB != pxCurrentTCB ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        traceRETURN_xTaskIsRunningOnAnotherCore( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_ADAPTIVE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRANSITIVE_PRIORITY_INHERITANCE == 1 )
+
+    static void prvReorderEventListItem( TCB_t * pxTCB )
+    {
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+        /* Only tasks blocked on a priority ordered event list are moved.  The
+         * pending ready list is not ordered, and the event list item value is
+         * not a priority if it is in use for anything else. */
+        if( ( pxEventList != NULL ) &&
+            ( pxEventList != &xPendingReadyList ) &&
+            ( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL ) )
+        {
+            ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_TRANSITIVE_PRIORITY_INHERITANCE */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
@@ -7970,7 +11270,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8085,7 +11385,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8230,7 +11530,15 @@ TickType_t uxTaskResetEventItemValue( void )
 
         traceENTER_ulTaskGetRunTimePercent( xTask );
 
-        ulTotalTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+            taskENTER_CRITICAL();
+            {
+                ulTotalTime = prvGetRunTimeCounterValue();
+            }
+            taskEXIT_CRITICAL();
+        #else
+            ulTotalTime = ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
 
         /* For percentage calculations. */
         ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
@@ -8286,7 +11594,15 @@ TickType_t uxTaskResetEventItemValue( void )
 
         traceENTER_ulTaskGetIdleRunTimePercent();
 
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE() * configNUMBER_OF_CORES;
+        #if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+            taskENTER_CRITICAL();
+            {
+                ulTotalTime = prvGetRunTimeCounterValue() * configNUMBER_OF_CORES;
+            }
+            taskEXIT_CRITICAL();
+        #else
+            ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE() * configNUMBER_OF_CORES;
+        #endif
 
         /* For percentage calculations. */
         ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
@@ -8314,8 +11630,121 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+        uint32_t ulCounterValue, ulDifference;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulCounterValue );
+        #else
+            ulCounterValue = ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* Must be called with the kernel lock held, as the extension is shared
+         * by all cores.  Core 0 reads the counter on every tick, and the number
+         * of ticks that can be suppressed is limited by
+         * configRUN_TIME_COUNTER_WRAP_TICKS, so the low 32 bits of the counter
+         * move forward by less than half their range between reads.  A value
+         * up to half the range ahead of the last value is therefore taken as
+         * the counter moving forward, wrapping if it is numerically lower.  A
+         * value behind the last value was read from a counter slightly behind
+         * the one last read, for example on another core, so is returned
+         * relative to the last value without moving the extension back. */
+        ulDifference = ulCounterValue - ( uint32_t ) ulLastRunTimeCounterValue;
+
+        if( ulDifference < 0x80000000UL )
+        {
+            ulLastRunTimeCounterValue += ( configRUN_TIME_COUNTER_TYPE ) ulDifference;
+            ulReturn = ulLastRunTimeCounterValue;
+        }
+        else
+        {
+            ulReturn = ulLastRunTimeCounterValue - ( configRUN_TIME_COUNTER_TYPE ) ( ( uint32_t ) ulLastRunTimeCounterValue - ulCounterValue );
+        }
+
+        return ulReturn;
+    }
+
+#endif /* if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounterForCore( const TaskHandle_t xTask,
+                                                                BaseType_t xCoreID )
+    {
+        TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+
+        traceENTER_ulTaskGetRunTimeCounterForCore( xTask, xCoreID );
+
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* The counter may be wider than the architecture, so read it in a
+         * critical section to prevent a context switch updating it part way
+         * through the read. */
+        taskENTER_CRITICAL();
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                ( void ) xCoreID;
+                ulReturn = pxTCB->ulRunTimeCounter;
+            }
+            #else
+            {
+                ulReturn = pxTCB->ulRunTimeCounterPerCore[ xCoreID ];
+            }
+            #endif
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulTaskGetRunTimeCounterForCore( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID )
+    {
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+
+        traceENTER_ulTaskGetIdleRunTimeCounterForCore( xCoreID );
+
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+        taskENTER_CRITICAL();
+        {
+            ulReturn = ulCoreIdleRunTime[ xCoreID ];
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_ulTaskGetIdleRunTimeCounterForCore( ulReturn );
+
+        return ulReturn;
+    }
+
+#endif /* if ( configUSE_64_BIT_RUN_TIME_COUNTER == 1 ) */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
+{
+    prvAddCurrentTaskToDelayedListFrom( taskGET_TICK_COUNT_NOW(), xTicksToWait, xCanBlockIndefinitely );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddCurrentTaskToDelayedListFrom( const TickType_t xTimeNow,
+                                                TickType_t xTicksToWait,
+                                                const BaseType_t xCanBlockIndefinitely )
 {
     TickType_t xTimeToWake;
     const TickType_t xConstTickCount = xTickCount;
@@ -8329,6 +11758,22 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
+    {
+        /* The wheel bucket for the current tick has already been processed, so
+         * a task cannot be placed in it.  Blocking for zero ticks unblocks the
+         * task on the next tick, as it does when the delayed lists are used. */
+        if( xTicksToWait == ( TickType_t ) 0U )
+        {
+            xTicksToWait = ( TickType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMING_WHEEL_DELAY_LIST */
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -8356,37 +11801,48 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* Calculate the time at which the task should be woken if the event
              * does not occur.  This may overflow but this doesn't matter, the
              * kernel will manage it correctly. */
-            xTimeToWake = xConstTickCount + xTicksToWait;
+            xTimeToWake = xTimeNow + xTicksToWait;
 
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            if( xTimeToWake < xConstTickCount )
+            #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                /* The wheel handles wake times that have overflowed, and
+                 * updates xNextTaskUnblockTime if necessary. */
+                traceMOVED_TASK_TO_DELAYED_LIST();
+                prvInsertIntoDelayedWheel( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
             }
-            else
+            #else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 ) */
             {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                traceMOVED_TASK_TO_DELAYED_LIST();
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+                if( xTimeToWake < xConstTickCount )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    traceMOVED_TASK_TO_DELAYED_LIST();
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+            #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 ) */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -8394,35 +11850,44 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* Calculate the time at which the task should be woken if the event
          * does not occur.  This may overflow but this doesn't matter, the kernel
          * will manage it correctly. */
-        xTimeToWake = xConstTickCount + xTicksToWait;
+        xTimeToWake = xTimeNow + xTicksToWait;
 
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-        if( xTimeToWake < xConstTickCount )
+        #if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 )
         {
-            traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            traceMOVED_TASK_TO_DELAYED_LIST();
+            prvInsertIntoDelayedWheel( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
         }
-        else
+        #else /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 ) */
         {
-            traceMOVED_TASK_TO_DELAYED_LIST();
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( xTimeToWake < xConstTickCount )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                traceMOVED_TASK_TO_DELAYED_LIST();
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* if ( configUSE_TIMING_WHEEL_DELAY_LIST == 1 ) */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
@@ -0,0 +1,88 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Configuration used by the tests that run on the POSIX port.  Each test is a
+ * separate program, but they all share this configuration, so the kernel is
+ * only built once. */
+
+#define configUSE_PREEMPTION                         1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION      0
+#define configUSE_IDLE_HOOK                          0
+#define configUSE_TICK_HOOK                          0
+#define configTICK_RATE_HZ                           1000
+#define configMAX_PRIORITIES                         10
+#define configMINIMAL_STACK_SIZE                     4096
+#define configTOTAL_HEAP_SIZE                        ( 4 * 1024 * 1024 )
+#define configMAX_TASK_NAME_LEN                      16
+#define configUSE_TRACE_FACILITY                     1
+#define configUSE_16_BIT_TICKS                       0
+#define configIDLE_SHOULD_YIELD                      1
+#define configUSE_MUTEXES                            1
+#define configUSE_RECURSIVE_MUTEXES                  1
+#define configUSE_COUNTING_SEMAPHORES                1
+#define configQUEUE_REGISTRY_SIZE                    0
+#define configCHECK_FOR_STACK_OVERFLOW               0
+#define configUSE_MALLOC_FAILED_HOOK                 0
+#define configSUPPORT_STATIC_ALLOCATION              1
+#define configSUPPORT_DYNAMIC_ALLOCATION             1
+#define configKERNEL_PROVIDED_STATIC_MEMORY          1
+#define configUSE_TIMERS                             1
+#define configTIMER_TASK_PRIORITY                    ( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH                     10
+#define configTIMER_TASK_STACK_DEPTH                 configMINIMAL_STACK_SIZE
+#define configUSE_TASK_NOTIFICATIONS                 1
+
+/* Features under test. */
+#define configUSE_TRANSITIVE_PRIORITY_INHERITANCE    1
+
+/* A small delayed task wheel, so the delays used by the tests reach every
+ * level of the wheel and its overflow list.  Only used when
+ * configUSE_TIMING_WHEEL_DELAY_LIST is set to 1 (see CMakeLists.txt). */
+#define configTIMING_WHEEL_BITS_PER_LEVEL            4
+#define configTIMING_WHEEL_LEVELS                    2
+
+#define INCLUDE_vTaskPrioritySet                     1
+#define INCLUDE_uxTaskPriorityGet                    1
+#define INCLUDE_vTaskDelete                          1
+#define INCLUDE_vTaskSuspend                         1
+#define INCLUDE_vTaskDelay                           1
+#define INCLUDE_xTaskGetSchedulerState               1
+#define INCLUDE_xTaskGetCurrentTaskHandle            1
+#define INCLUDE_eTaskGetState                        1
+#define INCLUDE_xSemaphoreGetMutexHolder             1
+
+/* A failed assert fails the test. */
+extern void vAssertCalled( const char * pcFile,
+                           unsigned long ulLine );
+#define configASSERT( x )    if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,135 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Tests that tasks delayed for different lengths of time wake on the tick at
+ * which their delay expires.
+ *
+ * When configUSE_TIMING_WHEEL_DELAY_LIST is 1 the delays are chosen so tasks
+ * are placed in every level of the delayed task wheel and in its overflow
+ * list, and so are cascaded from one level to the next before they wake.  The
+ * FreeRTOSConfig.h in this folder uses a small wheel so the delays stay short.
+ * The test also passes with the default delayed task lists.
+ */
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define testCONTROL_PRIORITY    ( configMAX_PRIORITIES - 2U )
+#define testDELAY_PRIORITY      ( configMAX_PRIORITIES - 3U )
+
+/* Each delayed task delays this many times, starting at a different offset
+ * into a bucket of the wheel each time. */
+#define testROUNDS              ( 3U )
+
+/* The time a task can take to run after its delay expires, allowing for the
+ * host scheduling the thread that runs the task late. */
+#define testWAKE_TOLERANCE      ( ( TickType_t ) 5U )
+
+/* The delays, in ticks.  With the configuration used by the tests the wheel
+ * has two levels of 16 buckets, so level 0 spans 16 ticks, level 1 spans 256
+ * ticks, and longer delays start in the overflow list. */
+static const TickType_t xDelays[] =
+{
+    1U, 15U, 16U, 17U, 40U, 255U, 256U, 300U, 600U
+};
+
+#define testNUM_DELAYS          ( sizeof( xDelays ) / sizeof( xDelays[ 0 ] ) )
+
+static TaskHandle_t xControlTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+static void prvDelayTask( void * pvParameters )
+{
+    const TickType_t xDelay = *( ( const TickType_t * ) pvParameters );
+    TickType_t xStart;
+    TickType_t xElapsed;
+    UBaseType_t uxRound;
+
+    for( uxRound = 0U; uxRound < testROUNDS; uxRound++ )
+    {
+        /* Start each round at a different point in the current bucket. */
+        vTaskDelay( ( TickType_t ) ( uxRound + 3U ) );
+
+        xStart = xTaskGetTickCount();
+        vTaskDelay( xDelay );
+        xElapsed = xTaskGetTickCount() - xStart;
+
+        TEST_CHECK( xElapsed >= xDelay );
+        TEST_CHECK( xElapsed <= ( xDelay + testWAKE_TOLERANCE ) );
+    }
+
+    ( void ) xTaskNotifyGive( xControlTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    /* Longer than the longest delay for every round, so the test fails
+     * rather than hangs if a task never wakes. */
+    const TickType_t xTimeout = pdMS_TO_TICKS( 10000 );
+    TimeOut_t xTimeOut;
+    TickType_t xTicksToWait = xTimeout;
+    UBaseType_t uxDone = 0U;
+    UBaseType_t x;
+
+    ( void ) pvParameters;
+
+    for( x = 0U; x < testNUM_DELAYS; x++ )
+    {
+        ( void ) xTaskCreate( prvDelayTask, "Delay", configMINIMAL_STACK_SIZE, ( void * ) &( xDelays[ x ] ), testDELAY_PRIORITY, NULL );
+    }
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    while( ( uxDone < testNUM_DELAYS ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) )
+    {
+        uxDone += ( UBaseType_t ) ulTaskNotifyTake( pdFALSE, xTicksToWait );
+    }
+
+    TEST_CHECK( uxDone == testNUM_DELAYS );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, testCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    /* The scheduler only returns if it could not be started. */
+    return 1;
+}
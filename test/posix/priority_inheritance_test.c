@@ -0,0 +1,429 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Tests for transitive priority inheritance through chains of mutexes, as
+ * enabled by configUSE_TRANSITIVE_PRIORITY_INHERITANCE.
+ *
+ * Each test builds a chain of tasks in which every task holds one mutex and is
+ * blocked on the mutex held by the next task in the chain.  The last task in
+ * the chain holds its mutex until it is notified.  Higher priority tasks then
+ * block on, or time out waiting for, the mutex at the head of the chain, and
+ * the test checks the priority of every task in the chain.  The control task
+ * runs at a higher priority than all the other tasks, so the chain is always
+ * observed while the other tasks are blocked.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "test_common.h"
+
+#define testCONTROL_PRIORITY      ( configMAX_PRIORITIES - 2U )
+#define testBASE_PRIORITY         ( 1U )
+
+/* Long enough for the tasks that have just been created or notified to run
+ * until they block. */
+#define testSETTLE_TICKS          pdMS_TO_TICKS( 10 )
+
+/* The longest chain built by the tests is one task longer than the depth to
+ * which priorities are inherited. */
+#define testMAX_CHAIN_LENGTH      ( configMAX_PRIORITY_INHERITANCE_DEPTH + 1 )
+
+/* The states of a task waiting for the mutex at the head of a chain. */
+#define testWAITING               ( 0 )
+#define testTOOK_MUTEX            ( 1 )
+#define testTIMED_OUT             ( 2 )
+
+/* One task in a chain. */
+typedef struct ChainLink
+{
+    SemaphoreHandle_t xHeldMutex;        /* Taken when the task starts, and given when it finishes. */
+    SemaphoreHandle_t xWantedMutex;      /* The mutex the task blocks on, or NULL if the task is the last in the chain. */
+    UBaseType_t uxPriority;              /* The base priority of the task. */
+    char cTag;                           /* Recorded when the task stops waiting. */
+    TaskHandle_t xTask;
+    volatile UBaseType_t uxPriorityOnExit; /* The priority of the task after it has given xHeldMutex. */
+} ChainLink_t;
+
+/* A task that waits for a mutex, but does not hold one. */
+typedef struct Waiter
+{
+    SemaphoreHandle_t xWantedMutex;
+    TickType_t xTicksToWait;
+    UBaseType_t uxPriority;
+    char cTag;
+    TaskHandle_t xTask;
+    volatile BaseType_t xState;
+} Waiter_t;
+
+static char cOrder[ 32 ];
+static volatile UBaseType_t uxOrderLength = 0U;
+static volatile UBaseType_t uxFinishedTasks = 0U;
+
+/*-----------------------------------------------------------*/
+
+static void prvRecord( char cTag )
+{
+    taskENTER_CRITICAL();
+    {
+        if( uxOrderLength < ( sizeof( cOrder ) - 1U ) )
+        {
+            cOrder[ uxOrderLength ] = cTag;
+            uxOrderLength++;
+            cOrder[ uxOrderLength ] = '\0';
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvFinish( void )
+{
+    taskENTER_CRITICAL();
+    {
+        uxFinishedTasks++;
+    }
+    taskEXIT_CRITICAL();
+
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTask( void * pvParameters )
+{
+    ChainLink_t * const pxLink = ( ChainLink_t * ) pvParameters;
+
+    TEST_CHECK( xSemaphoreTake( pxLink->xHeldMutex, 0 ) == pdTRUE );
+
+    if( pxLink->xWantedMutex != NULL )
+    {
+        TEST_CHECK( xSemaphoreTake( pxLink->xWantedMutex, portMAX_DELAY ) == pdTRUE );
+        prvRecord( pxLink->cTag );
+        TEST_CHECK( xSemaphoreGive( pxLink->xWantedMutex ) == pdTRUE );
+    }
+    else
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        prvRecord( pxLink->cTag );
+    }
+
+    TEST_CHECK( xSemaphoreGive( pxLink->xHeldMutex ) == pdTRUE );
+
+    /* All the priority this task inherited must have been given up. */
+    pxLink->uxPriorityOnExit = uxTaskPriorityGet( NULL );
+
+    prvFinish();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void * pvParameters )
+{
+    Waiter_t * const pxWaiter = ( Waiter_t * ) pvParameters;
+
+    if( xSemaphoreTake( pxWaiter->xWantedMutex, pxWaiter->xTicksToWait ) == pdTRUE )
+    {
+        prvRecord( pxWaiter->cTag );
+        TEST_CHECK( xSemaphoreGive( pxWaiter->xWantedMutex ) == pdTRUE );
+        pxWaiter->xState = testTOOK_MUTEX;
+    }
+    else
+    {
+        pxWaiter->xState = testTIMED_OUT;
+    }
+
+    prvFinish();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Create the tasks of a chain, starting with the last task so each mutex is
+ * held before the previous task in the chain blocks on it.
+ */
+static void prvCreateChain( ChainLink_t * pxLinks,
+                            UBaseType_t uxLength )
+{
+    UBaseType_t ux;
+
+    for( ux = 0U; ux < uxLength; ux++ )
+    {
+        pxLinks[ ux ].xHeldMutex = xSemaphoreCreateMutex();
+        TEST_CHECK( pxLinks[ ux ].xHeldMutex != NULL );
+        pxLinks[ ux ].uxPriorityOnExit = 0U;
+    }
+
+    for( ux = uxLength; ux > 0U; ux-- )
+    {
+        ChainLink_t * const pxLink = &( pxLinks[ ux - 1U ] );
+
+        pxLink->xWantedMutex = ( ux < uxLength ) ? pxLinks[ ux ].xHeldMutex : NULL;
+        TEST_CHECK( xTaskCreate( prvChainTask, "Chain", configMINIMAL_STACK_SIZE, pxLink, pxLink->uxPriority, &( pxLink->xTask ) ) == pdPASS );
+        vTaskDelay( testSETTLE_TICKS );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateWaiter( Waiter_t * pxWaiter )
+{
+    pxWaiter->xState = testWAITING;
+    TEST_CHECK( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, pxWaiter, pxWaiter->uxPriority, &( pxWaiter->xTask ) ) == pdPASS );
+    vTaskDelay( testSETTLE_TICKS );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Release the last task in the chain, then wait for all uxTasks tasks created
+ * by the test to finish before deleting the mutexes.
+ */
+static void prvReleaseChain( ChainLink_t * pxLinks,
+                             UBaseType_t uxLength,
+                             UBaseType_t uxTasks )
+{
+    UBaseType_t ux;
+
+    ( void ) xTaskNotifyGive( pxLinks[ uxLength - 1U ].xTask );
+
+    for( ux = 0U; ( ux < 100U ) && ( uxFinishedTasks < uxTasks ); ux++ )
+    {
+        vTaskDelay( testSETTLE_TICKS );
+    }
+
+    TEST_CHECK( uxFinishedTasks == uxTasks );
+
+    for( ux = 0U; ux < uxLength; ux++ )
+    {
+        TEST_CHECK( pxLinks[ ux ].uxPriorityOnExit == pxLinks[ ux ].uxPriority );
+        vSemaphoreDelete( pxLinks[ ux ].xHeldMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetRecords( void )
+{
+    uxOrderLength = 0U;
+    cOrder[ 0 ] = '\0';
+    uxFinishedTasks = 0U;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * A waits for M0, held by B, which is blocked on M1, held by C, which is
+ * blocked on M2, held by D.  All of B, C and D inherit the priority of A, and
+ * return to their own priorities as the chain unwinds.
+ */
+static void prvTestThreeLevelChain( void )
+{
+    ChainLink_t xLinks[ 3 ] =
+    {
+        { .uxPriority = testBASE_PRIORITY + 1U, .cTag = 'B' },
+        { .uxPriority = testBASE_PRIORITY,      .cTag = 'C' },
+        { .uxPriority = testBASE_PRIORITY,      .cTag = 'D' }
+    };
+    Waiter_t xWaiter = { .xTicksToWait = portMAX_DELAY, .uxPriority = testBASE_PRIORITY + 3U, .cTag = 'A' };
+
+    prvResetRecords();
+    prvCreateChain( xLinks, 3U );
+
+    /* B blocking on M1 already raises both C and D to the priority of B. */
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xLinks[ 0 ].uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 2 ].xTask ) == xLinks[ 0 ].uxPriority );
+
+    xWaiter.xWantedMutex = xLinks[ 0 ].xHeldMutex;
+    prvCreateWaiter( &xWaiter );
+
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 2 ].xTask ) == xWaiter.uxPriority );
+
+    prvReleaseChain( xLinks, 3U, 4U );
+
+    TEST_CHECK( xWaiter.xState == testTOOK_MUTEX );
+    TEST_CHECK( strcmp( cOrder, "DCBA" ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * A chain one task longer than configMAX_PRIORITY_INHERITANCE_DEPTH.  Every
+ * task except the last inherits the priority of the waiting task.
+ */
+static void prvTestDepthBound( void )
+{
+    ChainLink_t xLinks[ testMAX_CHAIN_LENGTH ];
+    Waiter_t xWaiter = { .xTicksToWait = portMAX_DELAY, .uxPriority = testBASE_PRIORITY + 3U, .cTag = 'A' };
+    UBaseType_t ux;
+
+    prvResetRecords();
+    ( void ) memset( xLinks, 0, sizeof( xLinks ) );
+
+    for( ux = 0U; ux < testMAX_CHAIN_LENGTH; ux++ )
+    {
+        xLinks[ ux ].uxPriority = testBASE_PRIORITY;
+        xLinks[ ux ].cTag = ( char ) ( 'a' + ( char ) ux );
+    }
+
+    prvCreateChain( xLinks, testMAX_CHAIN_LENGTH );
+
+    xWaiter.xWantedMutex = xLinks[ 0 ].xHeldMutex;
+    prvCreateWaiter( &xWaiter );
+
+    for( ux = 0U; ux < ( testMAX_CHAIN_LENGTH - 1U ); ux++ )
+    {
+        TEST_CHECK( uxTaskPriorityGet( xLinks[ ux ].xTask ) == xWaiter.uxPriority );
+    }
+
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ testMAX_CHAIN_LENGTH - 1U ].xTask ) == testBASE_PRIORITY );
+
+    prvReleaseChain( xLinks, testMAX_CHAIN_LENGTH, testMAX_CHAIN_LENGTH + 1U );
+
+    TEST_CHECK( xWaiter.xState == testTOOK_MUTEX );
+    TEST_CHECK( uxOrderLength == ( testMAX_CHAIN_LENGTH + 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * As prvTestThreeLevelChain(), but W is also waiting for M1, and A times out.
+ * B has no other waiter so returns to its own priority, whereas C and D keep
+ * the priority of W.
+ */
+static void prvTestTimeoutDisinherit( void )
+{
+    ChainLink_t xLinks[ 3 ] =
+    {
+        { .uxPriority = testBASE_PRIORITY + 1U, .cTag = 'B' },
+        { .uxPriority = testBASE_PRIORITY,      .cTag = 'C' },
+        { .uxPriority = testBASE_PRIORITY,      .cTag = 'D' }
+    };
+    Waiter_t xOtherWaiter = { .xTicksToWait = portMAX_DELAY, .uxPriority = testBASE_PRIORITY + 2U, .cTag = 'W' };
+    Waiter_t xWaiter = { .xTicksToWait = pdMS_TO_TICKS( 50 ), .uxPriority = testBASE_PRIORITY + 3U, .cTag = 'A' };
+
+    prvResetRecords();
+    prvCreateChain( xLinks, 3U );
+
+    xOtherWaiter.xWantedMutex = xLinks[ 1 ].xHeldMutex;
+    prvCreateWaiter( &xOtherWaiter );
+
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xLinks[ 0 ].uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xOtherWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 2 ].xTask ) == xOtherWaiter.uxPriority );
+
+    xWaiter.xWantedMutex = xLinks[ 0 ].xHeldMutex;
+    prvCreateWaiter( &xWaiter );
+
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 2 ].xTask ) == xWaiter.uxPriority );
+
+    vTaskDelay( xWaiter.xTicksToWait + testSETTLE_TICKS );
+
+    TEST_CHECK( xWaiter.xState == testTIMED_OUT );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xLinks[ 0 ].uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xOtherWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 2 ].xTask ) == xOtherWaiter.uxPriority );
+
+    /* W is a higher priority than B, so takes M1 first. */
+    prvReleaseChain( xLinks, 3U, 5U );
+
+    TEST_CHECK( xOtherWaiter.xState == testTOOK_MUTEX );
+    TEST_CHECK( strcmp( cOrder, "DCWB" ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Two tasks of different priorities wait for M0, held by B, which is blocked
+ * on M1, held by C.  As each waiter times out, B and C drop to the priority of
+ * the highest priority task still waiting.
+ */
+static void prvTestSuccessiveTimeouts( void )
+{
+    ChainLink_t xLinks[ 2 ] =
+    {
+        { .uxPriority = testBASE_PRIORITY, .cTag = 'B' },
+        { .uxPriority = testBASE_PRIORITY, .cTag = 'C' }
+    };
+    Waiter_t xHighWaiter = { .xTicksToWait = pdMS_TO_TICKS( 20 ), .uxPriority = testBASE_PRIORITY + 4U, .cTag = 'H' };
+    Waiter_t xLowWaiter = { .xTicksToWait = pdMS_TO_TICKS( 60 ), .uxPriority = testBASE_PRIORITY + 3U, .cTag = 'L' };
+
+    prvResetRecords();
+    prvCreateChain( xLinks, 2U );
+
+    xHighWaiter.xWantedMutex = xLinks[ 0 ].xHeldMutex;
+    xLowWaiter.xWantedMutex = xLinks[ 0 ].xHeldMutex;
+    prvCreateWaiter( &xHighWaiter );
+    prvCreateWaiter( &xLowWaiter );
+
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xHighWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xHighWaiter.uxPriority );
+
+    /* The high priority waiter was created first, so times out first. */
+    vTaskDelay( pdMS_TO_TICKS( 25 ) );
+
+    TEST_CHECK( xHighWaiter.xState == testTIMED_OUT );
+    TEST_CHECK( xLowWaiter.xState == testWAITING );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == xLowWaiter.uxPriority );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == xLowWaiter.uxPriority );
+
+    vTaskDelay( pdMS_TO_TICKS( 50 ) );
+
+    TEST_CHECK( xLowWaiter.xState == testTIMED_OUT );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 0 ].xTask ) == testBASE_PRIORITY );
+    TEST_CHECK( uxTaskPriorityGet( xLinks[ 1 ].xTask ) == testBASE_PRIORITY );
+
+    prvReleaseChain( xLinks, 2U, 4U );
+
+    TEST_CHECK( strcmp( cOrder, "CB" ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvTestThreeLevelChain();
+    prvTestDepthBound();
+    prvTestTimeoutDisinherit();
+    prvTestSuccessiveTimeouts();
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, testCONTROL_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    /* The scheduler only returns if it could not be started. */
+    return 1;
+}
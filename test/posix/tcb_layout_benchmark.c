@@ -0,0 +1,164 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Measures the cost of a task switch, and checks the TCB layout selected by
+ * configTCB_CACHE_LINE_SIZE.
+ *
+ * Two tasks of the same priority hand a task notification back and forth, so
+ * every switch blocks one task and unblocks the other, which is the path that
+ * uses the TCB members grouped at the start of the TCB.  The time per switch is
+ * printed so builds with and without the cache line layout can be compared:
+ *
+ *   cmake -S . -B build -DTCB_CACHE_LINE_SIZE=0
+ *   cmake -S . -B build64 -DTCB_CACHE_LINE_SIZE=64
+ *
+ * On the POSIX port each switch signals a host thread, which costs far more
+ * than the TCB accesses, so the figures only show the layout has no cost here.
+ * The difference is expected on cached targets that switch in a few hundred
+ * cycles.  The program fails only if the layout checks fail.
+ */
+
+/* Standard includes. */
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "test_common.h"
+
+#define benchCONTROL_PRIORITY    ( configMAX_PRIORITIES - 2U )
+#define benchSWITCH_PRIORITY     ( 1U )
+
+/* Each round trip is two task switches. */
+#define benchROUND_TRIPS         ( 50000UL )
+
+static TaskHandle_t xPingTask = NULL;
+static TaskHandle_t xPongTask = NULL;
+static TaskHandle_t xControlTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+static void prvCheckLayout( void )
+{
+    #if ( configTCB_CACHE_LINE_SIZE > 0 )
+    {
+        const size_t xHotSize = offsetof( struct xSTATIC_TCB_HOT_MEMBERS, ucDummyEnd );
+        const size_t xColdStart = offsetof( StaticTask_t, ucDummy7 );
+
+        /* The members that are rarely used start on a cache line boundary,
+         * after at most one partly used line. */
+        TEST_CHECK( ( xColdStart % configTCB_CACHE_LINE_SIZE ) == 0U );
+        TEST_CHECK( xColdStart >= xHotSize );
+        TEST_CHECK( ( xColdStart - xHotSize ) < configTCB_CACHE_LINE_SIZE );
+
+        ( void ) printf( "TCB cache line size %u: %u bytes grouped, %u bytes of padding\n",
+                         ( unsigned ) configTCB_CACHE_LINE_SIZE,
+                         ( unsigned ) xHotSize,
+                         ( unsigned ) tskTCB_CACHE_LINE_PADDING );
+    }
+    #else
+    {
+        ( void ) printf( "TCB cache line layout disabled\n" );
+    }
+    #endif
+
+    ( void ) printf( "sizeof( StaticTask_t ) %u\n", ( unsigned ) sizeof( StaticTask_t ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void * pvParameters )
+{
+    unsigned long ulRoundTrip;
+
+    ( void ) pvParameters;
+
+    for( ulRoundTrip = 0UL; ulRoundTrip < benchROUND_TRIPS; ulRoundTrip++ )
+    {
+        ( void ) xTaskNotifyGive( xPongTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    ( void ) xTaskNotifyGive( xControlTask );
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        ( void ) xTaskNotifyGive( xPingTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void * pvParameters )
+{
+    struct timespec xStart;
+    struct timespec xEnd;
+    double dNanoseconds;
+
+    ( void ) pvParameters;
+
+    prvCheckLayout();
+
+    ( void ) xTaskCreate( prvPongTask, "Pong", configMINIMAL_STACK_SIZE, NULL, benchSWITCH_PRIORITY, &xPongTask );
+    ( void ) xTaskCreate( prvPingTask, "Ping", configMINIMAL_STACK_SIZE, NULL, benchSWITCH_PRIORITY, &xPingTask );
+
+    /* The control task runs at a higher priority, so the switches only start
+     * when it blocks here. */
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xStart );
+    ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xEnd );
+
+    dNanoseconds = ( ( double ) ( xEnd.tv_sec - xStart.tv_sec ) * 1e9 ) + ( double ) ( xEnd.tv_nsec - xStart.tv_nsec );
+    ( void ) printf( "%lu task switches, %.0f ns per switch\n",
+                     benchROUND_TRIPS * 2UL,
+                     dNanoseconds / ( ( double ) benchROUND_TRIPS * 2.0 ) );
+
+    vTestFinish();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    ( void ) xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, benchCONTROL_PRIORITY, &xControlTask );
+
+    vTaskStartScheduler();
+
+    /* The scheduler only returns if it could not be started. */
+    return 1;
+}
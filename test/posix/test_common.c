@@ -0,0 +1,63 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test_common.h"
+
+static volatile unsigned long ulFailedChecks = 0UL;
+
+void vTestCheckFailed( const char * pcFile,
+                       unsigned long ulLine,
+                       const char * pcCondition )
+{
+    ( void ) printf( "%s:%lu: check failed: %s\n", pcFile, ulLine, pcCondition );
+    ulFailedChecks++;
+}
+/*-----------------------------------------------------------*/
+
+void vTestFinish( void )
+{
+    ( void ) printf( "%s\n", ( ulFailedChecks == 0UL ) ? "PASS" : "FAIL" );
+    ( void ) fflush( stdout );
+
+    /* The POSIX port runs each task in its own thread, so end the whole
+     * program rather than just the scheduler. */
+    exit( ( ulFailedChecks == 0UL ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    ( void ) printf( "%s:%lu: assert failed\n", pcFile, ulLine );
+    ( void ) fflush( stdout );
+    abort();
+}
@@ -0,0 +1,56 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+/*
+ * Minimal support for the tests that run on the POSIX port.  A test calls
+ * TEST_CHECK() for each condition it verifies, then vTestFinish() to report the
+ * result and end the program.  The program exits with a non-zero status if any
+ * check failed, or if an assert failed, so the tests can be run by CTest.
+ */
+
+#include "FreeRTOS.h"
+
+#define TEST_CHECK( x )                                   \
+    do {                                                  \
+        if( !( x ) )                                      \
+        {                                                 \
+            vTestCheckFailed( __FILE__, __LINE__, #x );   \
+        }                                                 \
+    } while( 0 )
+
+void vTestCheckFailed( const char * pcFile,
+                       unsigned long ulLine,
+                       const char * pcCondition );
+
+void vTestFinish( void );
+
+#endif /* TEST_COMMON_H */
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+#/*
+# * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+# * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+# *
+# * SPDX-License-Identifier: MIT
+# *
+# * Permission is hereby granted, free of charge, to any person obtaining a copy of
+# * this software and associated documentation files (the "Software"), to deal in
+# * the Software without restriction, including without limitation the rights to
+# * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# * the Software, and to permit persons to whom the Software is furnished to do so,
+# * subject to the following conditions:
+# *
+# * The above copyright notice and this permission notice shall be included in all
+# * copies or substantial portions of the Software.
+# *
+# * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+# *
+# * https://www.FreeRTOS.org
+# * https://github.com/FreeRTOS
+# *
+# */
+
+"""
+Decodes the binary task statistics written by xTaskStatsEncode() and
+xTaskStatsEncodeToStreamBuffer().
+
+The input is a stream of 16 byte little endian records.  Each frame starts
+with a frame record, followed by the name and task records of the frame.  Delta
+encoded frames are converted back to absolute run times, so every frame must be
+decoded in order, starting from the first frame written by the encoder.
+
+Usage: task_stats_decoder.py [file]
+
+Reads from stdin if no file is given, and prints one table per frame.
+"""
+
+import struct
+import sys
+
+RECORD_SIZE = 16
+FORMAT_VERSION = 1
+
+RECORD_FRAME = 1
+RECORD_TASK = 2
+RECORD_NAME = 3
+
+FLAG_DELTA = 1
+
+# Must match the eTaskState enumeration in task.h.
+_TASK_STATES_ = ['Running', 'Ready', 'Blocked', 'Suspended', 'Deleted', 'Invalid']
+
+_FRAME_RECORD_ = struct.Struct('<BBBBHHII')
+_TASK_RECORD_ = struct.Struct('<BBBBIIHH')
+_NAME_RECORD_ = struct.Struct('<B11sI')
+
+_COUNTER_MASK_ = 0xFFFFFFFF
+
+
+class DecodeError(Exception):
+    pass
+
+
+class TaskStatsDecoder:
+    def __init__(self):
+        self._names = {}
+        self._run_times = {}
+        self._total_run_time = None
+        self._pending = b''
+
+    def feed(self, data):
+        """
+        Decodes as many complete frames as possible from data plus any bytes
+        left over from the previous call, and returns them as a list of
+        dictionaries.
+        """
+        self._pending += data
+        frames = []
+
+        while len(self._pending) >= RECORD_SIZE:
+            record_type, version, flags, _, record_count, _, total_run_time, tick_count = \
+                _FRAME_RECORD_.unpack_from(self._pending, 0)
+
+            if record_type != RECORD_FRAME:
+                raise DecodeError('expected a frame record, found type %d' % record_type)
+
+            if version != FORMAT_VERSION:
+                raise DecodeError('unsupported format version %d' % version)
+
+            frame_size = RECORD_SIZE * (1 + record_count)
+
+            if len(self._pending) < frame_size:
+                break
+
+            frames.append(self._decode_frame(flags, record_count, total_run_time, tick_count))
+            self._pending = self._pending[frame_size:]
+
+        return frames
+
+    def _decode_frame(self, flags, record_count, total_run_time, tick_count):
+        delta = (flags & FLAG_DELTA) != 0
+
+        if delta:
+            if self._total_run_time is None:
+                raise DecodeError('delta frame received before an absolute frame')
+
+            total_run_time = (self._total_run_time + total_run_time) & _COUNTER_MASK_
+
+        tasks = []
+        run_times = {}
+
+        for index in range(record_count):
+            offset = RECORD_SIZE * (1 + index)
+            record_type = self._pending[offset]
+
+            if record_type == RECORD_NAME:
+                _, name, number = _NAME_RECORD_.unpack_from(self._pending, offset)
+                self._names[number] = name.rstrip(b'\0').decode('ascii', 'replace')
+                # A task named in a delta frame is new, so its run time is absolute.
+                self._run_times.pop(number, None)
+            elif record_type == RECORD_TASK:
+                _, state, priority, base_priority, number, run_time, stack, _ = \
+                    _TASK_RECORD_.unpack_from(self._pending, offset)
+
+                if delta and number in self._run_times:
+                    run_time = (self._run_times[number] + run_time) & _COUNTER_MASK_
+
+                run_times[number] = run_time
+                tasks.append({
+                    'number': number,
+                    'name': self._names.get(number, '?'),
+                    'state': _TASK_STATES_[min(state, len(_TASK_STATES_) - 1)],
+                    'priority': priority,
+                    'base_priority': base_priority,
+                    'run_time': run_time,
+                    'stack_high_water_mark': stack,
+                })
+            else:
+                raise DecodeError('unknown record type %d' % record_type)
+
+        # Tasks missing from this frame have been deleted.
+        self._run_times = run_times
+        self._total_run_time = total_run_time
+
+        return {
+            'tick_count': tick_count,
+            'total_run_time': total_run_time,
+            'tasks': tasks,
+        }
+
+
+def print_frame(frame, output=sys.stdout):
+    total = frame['total_run_time']
+    output.write('Tick %u, total run time %u\n' % (frame['tick_count'], total))
+    output.write('%-11s %5s %-9s %4s %4s %10s %5s %6s\n' %
+                 ('Name', 'Num', 'State', 'Pri', 'Base', 'Run time', '%', 'Stack'))
+
+    for task in frame['tasks']:
+        percent = (100.0 * task['run_time'] / total) if total else 0.0
+        output.write('%-11s %5u %-9s %4u %4u %10u %5.1f %6u\n' %
+                     (task['name'], task['number'], task['state'], task['priority'],
+                      task['base_priority'], task['run_time'], percent,
+                      task['stack_high_water_mark']))
+
+    output.write('\n')
+
+
+def main():
+    if len(sys.argv) > 2:
+        sys.stderr.write('Usage: %s [file]\n' % sys.argv[0])
+        return 1
+
+    if len(sys.argv) == 2:
+        with open(sys.argv[1], 'rb') as input_file:
+            data = input_file.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    decoder = TaskStatsDecoder()
+
+    try:
+        for frame in decoder.feed(data):
+            print_frame(frame)
+    except DecodeError as error:
+        sys.stderr.write('task_stats_decoder: %s\n' % error)
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#/*
+# * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+# * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+# *
+# * SPDX-License-Identifier: MIT
+# *
+# * Permission is hereby granted, free of charge, to any person obtaining a copy of
+# * this software and associated documentation files (the "Software"), to deal in
+# * the Software without restriction, including without limitation the rights to
+# * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# * the Software, and to permit persons to whom the Software is furnished to do so,
+# * subject to the following conditions:
+# *
+# * The above copyright notice and this permission notice shall be included in all
+# * copies or substantial portions of the Software.
+# *
+# * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+# *
+# * https://www.FreeRTOS.org
+# * https://github.com/FreeRTOS
+# *
+
+"""
+Unit tests for task_stats_decoder.py.  The records are built here with the
+layout written by prvStatsEncodeFrame() in tasks.c.
+
+Usage: python3 test_task_stats_decoder.py
+"""
+
+import io
+import os
+import struct
+import sys
+import unittest
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+import task_stats_decoder as decoder
+
+
+def frame_record(record_count, total_run_time, tick_count, delta=False, version=decoder.FORMAT_VERSION):
+    flags = decoder.FLAG_DELTA if delta else 0
+    return struct.pack('<BBBBHHII', decoder.RECORD_FRAME, version, flags, 0,
+                       record_count, 0, total_run_time, tick_count)
+
+
+def name_record(number, name):
+    return struct.pack('<B11sI', decoder.RECORD_NAME, name.encode('ascii'), number)
+
+
+def task_record(number, run_time, state=1, priority=1, base_priority=1, stack=100):
+    return struct.pack('<BBBBIIHH', decoder.RECORD_TASK, state, priority,
+                       base_priority, number, run_time, stack, 0)
+
+
+class TaskStatsDecoderTest(unittest.TestCase):
+    def setUp(self):
+        self.decoder = decoder.TaskStatsDecoder()
+
+    def test_record_size(self):
+        self.assertEqual(len(frame_record(0, 0, 0)), decoder.RECORD_SIZE)
+        self.assertEqual(len(name_record(1, 'IDLE')), decoder.RECORD_SIZE)
+        self.assertEqual(len(task_record(1, 0)), decoder.RECORD_SIZE)
+
+    def test_absolute_frame(self):
+        data = (frame_record(4, 1000, 50) +
+                name_record(1, 'IDLE') + task_record(1, 900, state=0, priority=0, base_priority=0) +
+                name_record(2, 'Tmr Svc') + task_record(2, 100, state=2, priority=3, base_priority=2, stack=64))
+
+        frames = self.decoder.feed(data)
+
+        self.assertEqual(len(frames), 1)
+        self.assertEqual(frames[0]['tick_count'], 50)
+        self.assertEqual(frames[0]['total_run_time'], 1000)
+        self.assertEqual(frames[0]['tasks'], [
+            {'number': 1, 'name': 'IDLE', 'state': 'Running', 'priority': 0,
+             'base_priority': 0, 'run_time': 900, 'stack_high_water_mark': 100},
+            {'number': 2, 'name': 'Tmr Svc', 'state': 'Blocked', 'priority': 3,
+             'base_priority': 2, 'run_time': 100, 'stack_high_water_mark': 64},
+        ])
+
+    def test_full_length_name(self):
+        frames = self.decoder.feed(frame_record(2, 0, 0) + name_record(7, 'ABCDEFGHIJK') + task_record(7, 0))
+
+        self.assertEqual(frames[0]['tasks'][0]['name'], 'ABCDEFGHIJK')
+
+    def test_delta_frame(self):
+        first = (frame_record(4, 1000, 10) +
+                 name_record(1, 'IDLE') + task_record(1, 900) +
+                 name_record(2, 'A') + task_record(2, 100))
+        # Task 2 is deleted and task 3 is created between the frames.
+        second = (frame_record(3, 500, 20, delta=True) +
+                  task_record(1, 300) +
+                  name_record(3, 'B') + task_record(3, 200))
+
+        frames = self.decoder.feed(first + second)
+
+        self.assertEqual(len(frames), 2)
+        self.assertEqual(frames[1]['total_run_time'], 1500)
+        self.assertEqual([(task['name'], task['run_time']) for task in frames[1]['tasks']],
+                         [('IDLE', 1200), ('B', 200)])
+
+    def test_delta_frame_wraps(self):
+        first = frame_record(2, 0xFFFFFF00, 0) + name_record(1, 'IDLE') + task_record(1, 0xFFFFFFF0)
+        second = frame_record(1, 0x200, 1, delta=True) + task_record(1, 0x20)
+
+        frames = self.decoder.feed(first + second)
+
+        self.assertEqual(frames[1]['total_run_time'], 0x100)
+        self.assertEqual(frames[1]['tasks'][0]['run_time'], 0x10)
+
+    def test_split_input(self):
+        data = frame_record(2, 10, 1) + name_record(1, 'IDLE') + task_record(1, 10)
+
+        self.assertEqual(self.decoder.feed(data[:20]), [])
+        self.assertEqual(self.decoder.feed(data[20:40]), [])
+        frames = self.decoder.feed(data[40:])
+
+        self.assertEqual(len(frames), 1)
+        self.assertEqual(frames[0]['tasks'][0]['run_time'], 10)
+
+    def test_delta_frame_first(self):
+        with self.assertRaises(decoder.DecodeError):
+            self.decoder.feed(frame_record(1, 10, 1, delta=True) + task_record(1, 10))
+
+    def test_bad_version(self):
+        with self.assertRaises(decoder.DecodeError):
+            self.decoder.feed(frame_record(0, 0, 0, version=decoder.FORMAT_VERSION + 1))
+
+    def test_missing_frame_record(self):
+        with self.assertRaises(decoder.DecodeError):
+            self.decoder.feed(task_record(1, 10))
+
+    def test_print_frame(self):
+        frames = self.decoder.feed(frame_record(2, 200, 5) + name_record(1, 'IDLE') + task_record(1, 50))
+        output = io.StringIO()
+
+        decoder.print_frame(frames[0], output)
+
+        self.assertIn('Tick 5, total run time 200', output.getvalue())
+        self.assertIn('25.0', output.getvalue())
+
+
+if __name__ == '__main__':
+    unittest.main()